@@ -54,6 +54,10 @@
 #include <string.h>
 #include "oscmsis.h"
 
+#if     OS_PRIO_LEVELS && OS_PRIO_LEVELS <= 56 /* osPriorityISR */
+#error  osconfig.h: CMSIS-RTOS2 requires OS_PRIO_LEVELS == 0 or OS_PRIO_LEVELS > 56
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 osStatus_t osKernelInitialize (void)
@@ -81,7 +85,7 @@ osStatus_t osKernelGetInfo (osVersion_t *version, char *id_buf, uint32_t id_size
 
 osKernelState_t osKernelGetState (void)
 {
-	return osKernelRunning;
+	return sys_schedCount() ? osKernelLocked : osKernelRunning;
 }
 
 osStatus_t osKernelStart (void)
@@ -100,8 +104,9 @@ int32_t osKernelLock (void)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	lock = port_get_lock();
-	port_set_lock();
+	lock = sys_schedCount() ? 1 : 0;
+	if (lock == 0)
+		sys_schedLock();
 	return lock;
 }
 
@@ -112,8 +117,9 @@ int32_t osKernelUnlock (void)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	lock = port_get_lock();
-	port_clr_lock();
+	lock = sys_schedCount() ? 1 : 0;
+	while (sys_schedCount())
+		sys_schedUnlock();
 	return lock;
 }
 
@@ -122,18 +128,62 @@ int32_t osKernelRestoreLock (int32_t lock)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	port_put_lock(lock);
+	if (lock == 1)
+	{
+		if (sys_schedCount() == 0)
+			sys_schedLock();
+	}
+	else
+	if (lock == 0)
+	{
+		while (sys_schedCount())
+			sys_schedUnlock();
+	}
+	else
+		return (int32_t)osError;
+
 	return lock;
 }
 
 uint32_t osKernelSuspend (void)
 {
-	return 0U;
+	cnt_t delay;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return 0U;
+
+	sys_lock();
+	{
+		port_tck_suspend();
+		delay = core_tmr_delay();
+	}
+	sys_unlock();
+
+	if (delay == INFINITE)
+		return osWaitForever;
+#if OS_TIMER_SIZE == 64
+	if (delay >= osWaitForever) // finite delay out of the range of the CMSIS tick count
+		return osWaitForever - 1U;
+#endif
+	return (uint32_t)delay;
 }
 
 void osKernelResume (uint32_t sleep_ticks)
 {
-	(void) sleep_ticks;
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return;
+
+#if HW_TIMER_SIZE == 0
+	core_sys_advance(sleep_ticks); // must be called outside the critical section
+#else
+	(void) sleep_ticks; // system timer is not stopped in tick-less mode
+#endif
+
+	sys_lock();
+	{
+		port_tck_resume();
+	}
+	sys_unlock();
 }
 
 uint32_t osKernelGetTickCount (void)
@@ -467,7 +517,7 @@ uint32_t osThreadGetCount (void)
 		for (tsk = IDLE.obj.next; tsk != &IDLE; tsk = tsk->obj.next)
 			count++;
 
-		for (tmr = WAIT.obj.next; tmr != &WAIT; tmr = tmr->obj.next)
+		for (tmr = core_tmr_next(&WAIT); tmr != &WAIT; tmr = core_tmr_next(tmr))
 			if (tmr->id == ID_DELAYED)
 				count++;
 	}
@@ -492,7 +542,7 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items)
 		for (tsk = IDLE.obj.next; (tsk != &IDLE) && (count < array_items); tsk = tsk->obj.next)
 			thread_array[count++] = tsk;
 
-		for (tmr = WAIT.obj.next; (tmr != &WAIT) && (count < array_items); tmr = tmr->obj.next)
+		for (tmr = core_tmr_next(&WAIT); (tmr != &WAIT) && (count < array_items); tmr = core_tmr_next(tmr))
 			if (tmr->id == ID_DELAYED)
 				thread_array[count++] = tmr;
 	}
@@ -833,7 +883,10 @@ osMutexId_t osMutexNew (const osMutexAttr_t *attr)
 
 	sys_lock();
 	{
-		mtx_init(&mutex->mtx);
+		if (flags & osMutexPrioProtect)
+			mtx_init(&mutex->mtx, mtxPrioProtect, osMutexCeilingGet(flags));
+		else
+			mtx_init(&mutex->mtx, mtxPrioInherit, 0);
 		if (attr->cb_mem == NULL || attr->cb_size == 0U) mutex->mtx.res = mutex;
 		mutex->flags = flags;
 		mutex->name = (attr == NULL) ? NULL : attr->name;
@@ -912,6 +965,147 @@ osStatus_t osMutexDelete (osMutexId_t mutex_id)
 
 /* -------------------------------------------------------------------------- */
 
+osRwLockId_t osRwLockNew (const osRwLockAttr_t *attr)
+{
+	osRwLock_t *rwlock = NULL;
+	uint32_t    flags = 0U;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return NULL;
+
+	if (attr != NULL)
+	{
+		flags = attr->attr_bits;
+
+		if (attr->cb_size != 0U)
+		{
+			rwlock = attr->cb_mem;
+			if (attr->cb_size != osRwLockCbSize)
+				return NULL;
+		}
+	}
+
+	if (rwlock == NULL)
+	{
+		rwlock = sys_alloc(osRwLockCbSize);
+		if (rwlock == NULL)
+			return NULL;
+	}
+
+	sys_lock();
+	{
+		rwl_init(&rwlock->rwl, (flags & osRwLockPreferReader) ? rwlPreferReader : rwlPreferWriter);
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) rwlock->rwl.res = rwlock;
+		rwlock->flags = flags;
+		rwlock->name = (attr == NULL) ? NULL : attr->name;
+	}
+	sys_unlock();
+
+	return rwlock;
+}
+
+const char *osRwLockGetName (osRwLockId_t rwlock_id)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED() || (rwlock_id == NULL))
+		return NULL;
+
+	return rwlock->name;
+}
+
+osStatus_t osRwLockAcquireRead (osRwLockId_t rwlock_id, uint32_t timeout)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+	if (rwlock_id == NULL)
+		return osErrorParameter;
+
+	switch (rwl_waitReadFor(&rwlock->rwl, timeout))
+	{
+		case E_SUCCESS: return osOK;
+		case E_TIMEOUT: return osErrorTimeout;
+		default:        return osErrorResource;
+	}
+}
+
+osStatus_t osRwLockReleaseRead (osRwLockId_t rwlock_id)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+	if (rwlock_id == NULL)
+		return osErrorParameter;
+
+	switch (rwl_giveRead(&rwlock->rwl))
+	{
+		case E_SUCCESS: return osOK;
+		default:        return osErrorResource;
+	}
+}
+
+osStatus_t osRwLockAcquireWrite (osRwLockId_t rwlock_id, uint32_t timeout)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+	if (rwlock_id == NULL)
+		return osErrorParameter;
+
+	switch (rwl_waitWriteFor(&rwlock->rwl, timeout))
+	{
+		case E_SUCCESS: return osOK;
+		case E_TIMEOUT: return osErrorTimeout;
+		default:        return osErrorResource;
+	}
+}
+
+osStatus_t osRwLockReleaseWrite (osRwLockId_t rwlock_id)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+	if (rwlock_id == NULL)
+		return osErrorParameter;
+
+	switch (rwl_giveWrite(&rwlock->rwl))
+	{
+		case E_SUCCESS: return osOK;
+		default:        return osErrorResource;
+	}
+}
+
+osThreadId_t osRwLockGetOwner (osRwLockId_t rwlock_id)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED() || (rwlock_id == NULL))
+		return NULL;
+
+	return rwlock->rwl.owner;
+}
+
+osStatus_t osRwLockDelete (osRwLockId_t rwlock_id)
+{
+	osRwLock_t *rwlock = rwlock_id;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return osErrorISR;
+	if (rwlock_id == NULL)
+		return osErrorParameter;
+
+	rwl_delete(&rwlock->rwl);
+
+	return osOK;
+}
+
+/* -------------------------------------------------------------------------- */
+
 osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
 {
 	osSemaphore_t *semaphore = NULL;
@@ -922,6 +1116,8 @@ osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, cons
 
 	if (attr != NULL)
 	{
+		flags = attr->attr_bits;
+
 		if (attr->cb_size != 0U)
 		{
 			semaphore = attr->cb_mem;
@@ -940,6 +1136,8 @@ osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, cons
 	sys_lock();
 	{
 		sem_init(&semaphore->sem, initial_count, max_count);
+		if (flags & osSemaphoreFifo)
+			sem_setMode(&semaphore->sem, semFifo);
 		if (attr->cb_mem == NULL || attr->cb_size == 0U) semaphore->sem.res = semaphore;
 		semaphore->flags = flags;
 		semaphore->name = (attr == NULL) ? NULL : attr->name;
@@ -1202,6 +1400,8 @@ osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, con
 
 	if (attr != NULL)
 	{
+		flags = attr->attr_bits;
+
 		if (attr->cb_size != 0U)
 		{
 			mq = attr->cb_mem;
@@ -1242,6 +1442,8 @@ osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, con
 	sys_lock();
 	{
 		box_init(&mq->box, msg_count, data, msg_size);
+		if (flags & osMessageQueueFifo)
+			box_setMode(&mq->box, boxFifo);
 		if (attr->cb_mem == NULL || attr->cb_size == 0U) mq->box.res = mq;
 		else
 		if (attr->mq_mem == NULL || attr->mq_size == 0U) mq->box.res = data;
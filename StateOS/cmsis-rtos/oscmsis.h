@@ -109,6 +109,82 @@ typedef struct __Mutex osMutex_t;
 
 #define osMutexCbSize sizeof(osMutex_t)
 
+// Mutex attributes (attr_bits in \ref osMutexAttr_t), StateOS extension.
+#define osMutexPrioProtect    0x00000010U ///< Priority ceiling protocol (instead of osMutexPrioInherit).
+#define osMutexCeiling(prio)  ((uint32_t)(prio) << 24) ///< Priority ceiling (osPriority_t) of the osMutexPrioProtect mutex.
+#define osMutexCeilingGet(flags) (((flags) >> 24) ? (unsigned)((flags) >> 24) : (unsigned)osPriorityRealtime7)
+
+/*---------------------------------------------------------------------------*/
+
+// Read-write lock, StateOS extension (not a part of the CMSIS-RTOS2 API).
+
+struct __RwLock
+{
+	rwl_t        rwl;   // StateOS read-write lock object
+	uint32_t     flags; // attribute bits
+	const char * name;  // read-write lock name
+};
+
+typedef struct __RwLock osRwLock_t;
+
+#define osRwLockCbSize sizeof(osRwLock_t)
+
+// Read-write lock attributes (attr_bits in \ref osRwLockAttr_t).
+#define osRwLockPreferReader  0x00000001U ///< New readers are admitted as long as no writer owns the lock (default: waiting writers block new readers).
+
+/// \details Read-write lock ID identifies the read-write lock.
+typedef void *osRwLockId_t;
+
+/// Attributes structure for read-write lock.
+typedef struct {
+  const char                   *name;   ///< name of the read-write lock
+  uint32_t                 attr_bits;   ///< attribute bits
+  void                      *cb_mem;    ///< memory for control block
+  uint32_t                   cb_size;   ///< size of provided memory for control block
+} osRwLockAttr_t;
+
+/// Create and Initialize a Read-Write Lock object.
+/// \param[in]     attr          read-write lock attributes; NULL: default values.
+/// \return read-write lock ID for reference by other functions or NULL in case of error.
+osRwLockId_t osRwLockNew (const osRwLockAttr_t *attr);
+
+/// Get name of a Read-Write Lock object.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \return name as null-terminated string.
+const char *osRwLockGetName (osRwLockId_t rwlock_id);
+
+/// Acquire a Read-Write Lock for reading (shared access) or timeout if it is locked for writing.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockAcquireRead (osRwLockId_t rwlock_id, uint32_t timeout);
+
+/// Release a Read-Write Lock that was acquired by \ref osRwLockAcquireRead.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockReleaseRead (osRwLockId_t rwlock_id);
+
+/// Acquire a Read-Write Lock for writing (exclusive access) or timeout if it is locked.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \param[in]     timeout       \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockAcquireWrite (osRwLockId_t rwlock_id, uint32_t timeout);
+
+/// Release a Read-Write Lock that was acquired by \ref osRwLockAcquireWrite.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockReleaseWrite (osRwLockId_t rwlock_id);
+
+/// Get Thread which owns a Read-Write Lock object for writing.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \return thread ID of owner thread or NULL when the lock is not locked for writing.
+osThreadId_t osRwLockGetOwner (osRwLockId_t rwlock_id);
+
+/// Delete a Read-Write Lock object.
+/// \param[in]     rwlock_id     read-write lock ID obtained by \ref osRwLockNew.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osRwLockDelete (osRwLockId_t rwlock_id);
+
 /*---------------------------------------------------------------------------*/
 
 struct __Semaphore
@@ -122,6 +198,9 @@ typedef struct __Semaphore osSemaphore_t;
 
 #define osSemaphoreCbSize sizeof(osSemaphore_t)
 
+// Semaphore attributes (attr_bits in \ref osSemaphoreAttr_t), StateOS extension.
+#define osSemaphoreFifo       0x00000001U ///< Waiting threads are released in the arrival order (not by priority).
+
 /*---------------------------------------------------------------------------*/
 
 struct __MemoryPool
@@ -150,6 +229,9 @@ typedef struct __MessageQueue osMessageQueue_t;
 #define osMessageQueueCbSize sizeof(osMessageQueue_t)
 #define osMessageQueueMemSize(count, size) (((((size)+3)/4)*4)*count)
 
+// Message queue attributes (attr_bits in \ref osMessageQueueAttr_t), StateOS extension.
+#define osMessageQueueFifo    0x00000001U ///< Waiting threads are released in the arrival order (not by priority).
+
 /* -------------------------------------------------------------------------- */
 
 #ifdef __cplusplus
@@ -304,6 +304,8 @@ unsigned cnd_wait( cnd_t *cnd, mtx_t *mtx ) { return cnd_waitFor(cnd, mtx, INFIN
  * Return            : none
  *
  * Note              : may be used both in thread and handler mode
+ *                     only a task that can lock its mutex is woken up, the other signalled tasks
+ *                     are moved directly to the mutex queue (wait morphing) and receive the mutex from its owner
  *
  ******************************************************************************/
 
@@ -125,6 +125,82 @@ void core_sys_unlock( lck_t lck )
 #define                sys_unlockISR() \
                        sys_unlock()
 
+/******************************************************************************
+ *
+ * Name              : sys_schedLock
+ *
+ * Description       : lock the scheduler (nestable)
+ *                     the current task is not preempted until the lock is released,
+ *                     interrupts remain enabled
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     the current task must not call any blocking function with the scheduler locked
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void sys_schedLock( void )
+{
+	assert(!port_isr_inside());
+
+	sys_lock();
+	{
+		core_sch_lock();
+	}
+	sys_unlock();
+}
+
+/******************************************************************************
+ *
+ * Name              : sys_schedUnlock
+ *
+ * Description       : unlock the scheduler
+ *                     the context switch deferred while the scheduler was locked
+ *                     is performed when the outermost lock is released
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void sys_schedUnlock( void )
+{
+	assert(!port_isr_inside());
+
+	sys_lock();
+	{
+		assert(System.sched);
+		core_sch_unlock();
+	}
+	sys_unlock();
+}
+
+/******************************************************************************
+ *
+ * Name              : sys_schedCount
+ *
+ * Description       : return nesting counter of the scheduler lock
+ *
+ * Parameters        : none
+ *
+ * Return            : nesting counter of the scheduler lock
+ *   0               : the scheduler is not locked
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned sys_schedCount( void ) { return System.sched; }
+
 #ifdef __cplusplus
 }
 #endif
@@ -153,6 +229,23 @@ struct CriticalSection
 	lck_t lck;
 };
 
+/******************************************************************************
+ *
+ * Class             : SchedulerLock
+ *
+ * Description       : create and initialize a scheduler lock guard object
+ *
+ * Constructor parameters
+ *                   : none
+ *
+ ******************************************************************************/
+
+struct SchedulerLock
+{
+	 SchedulerLock( void ) { sys_schedLock();   }
+	~SchedulerLock( void ) { sys_schedUnlock(); }
+};
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -52,12 +52,20 @@ struct __evq
 	void   * res;   // allocated event queue object's resource
 	unsigned count; // inherited from semaphore
 	unsigned limit; // inherited from semaphore
+	unsigned mode;  // inherited from semaphore
 
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	unsigned*data;  // data buffer
+
+	unsigned mask;  // index mask if the capacity is a power of two (free-running head and tail), otherwise zero
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define evqPrio      (  0U ) // waiting tasks are woken up in the priority order (default)
+#define evqFifo      (  1U ) // waiting tasks are woken up in the arrival order
+
 /******************************************************************************
  *
  * Name              : _EVQ_INIT
@@ -67,6 +75,9 @@ struct __evq
  * Parameters
  *   limit           : size of a queue (max number of stored events)
  *   data            : event queue data buffer
+ *   mode            : waiting mode
+ *                     evqPrio: tasks are woken up in the priority order
+ *                     evqFifo: tasks are woken up in the arrival order
  *
  * Return            : event queue object
  *
@@ -74,7 +85,7 @@ struct __evq
  *
  ******************************************************************************/
 
-#define               _EVQ_INIT( _limit, _data ) { 0, 0, 0, _limit, 0, 0, _data }
+#define               _EVQ_INIT( _limit, _data, _mode ) { 0, 0, 0, _limit, _mode, 0, 0, _data, POW2MASK( _limit ) }
 
 /******************************************************************************
  *
@@ -107,9 +118,9 @@ struct __evq
  *
  ******************************************************************************/
 
-#define             OS_EVQ( evq, limit )                                \
-                       unsigned evq##__buf[limit];                       \
-                       evq_t evq##__evq = _EVQ_INIT( limit, evq##__buf ); \
+#define             OS_EVQ( evq, limit )                                           \
+                       unsigned evq##__buf[limit];                                 \
+                       evq_t evq##__evq = _EVQ_INIT( limit, evq##__buf, evqPrio ); \
                        evq_id evq = & evq##__evq
 
 /******************************************************************************
@@ -124,11 +135,79 @@ struct __evq
  *
  ******************************************************************************/
 
-#define         static_EVQ( evq, limit )                                \
-                static unsigned evq##__buf[limit];                       \
-                static evq_t evq##__evq = _EVQ_INIT( limit, evq##__buf ); \
+#define         static_EVQ( evq, limit )                                           \
+                static unsigned evq##__buf[limit];                                 \
+                static evq_t evq##__evq = _EVQ_INIT( limit, evq##__buf, evqPrio ); \
+                static evq_id evq = & evq##__evq
+
+/******************************************************************************
+ *
+ * Name              : OS_EVQ_FIFO
+ *
+ * Description       : define and initialize an event queue object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   evq             : name of a pointer to event queue object
+ *   limit           : size of a queue (max number of stored events)
+ *
+ ******************************************************************************/
+
+#define             OS_EVQ_FIFO( evq, limit )                                      \
+                       unsigned evq##__buf[limit];                                 \
+                       evq_t evq##__evq = _EVQ_INIT( limit, evq##__buf, evqFifo ); \
+                       evq_id evq = & evq##__evq
+
+/******************************************************************************
+ *
+ * Name              : static_EVQ_FIFO
+ *
+ * Description       : define and initialize a static event queue object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   evq             : name of a pointer to event queue object
+ *   limit           : size of a queue (max number of stored events)
+ *
+ ******************************************************************************/
+
+#define         static_EVQ_FIFO( evq, limit )                                      \
+                static unsigned evq##__buf[limit];                                 \
+                static evq_t evq##__evq = _EVQ_INIT( limit, evq##__buf, evqFifo ); \
                 static evq_id evq = & evq##__evq
 
+/******************************************************************************
+ *
+ * Name              : OS_EVQ_POW2
+ *
+ * Description       : define and initialize an event queue object with the capacity being a power of two
+ *
+ * Parameters
+ *   evq             : name of a pointer to event queue object
+ *   limit           : size of a queue (max number of stored events)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_EVQ_POW2( evq, limit ) \
+                    OS_EVQ( evq, POW2( limit ) )
+
+/******************************************************************************
+ *
+ * Name              : static_EVQ_POW2
+ *
+ * Description       : define and initialize a static event queue object with the capacity being a power of two
+ *
+ * Parameters
+ *   evq             : name of a pointer to event queue object
+ *   limit           : size of a queue (max number of stored events)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_EVQ_POW2( evq, limit ) \
+                static_EVQ( evq, POW2( limit ) )
+
 /******************************************************************************
  *
  * Name              : EVQ_INIT
@@ -146,7 +225,7 @@ struct __evq
 
 #ifndef __cplusplus
 #define                EVQ_INIT( limit ) \
-                      _EVQ_INIT( limit, _EVQ_DATA( limit ) )
+                      _EVQ_INIT( limit, _EVQ_DATA( limit ), evqPrio )
 #endif
 
 /******************************************************************************
@@ -213,6 +292,26 @@ evq_t *evq_create( unsigned limit );
 __STATIC_INLINE
 evq_t *evq_new( unsigned limit ) { return evq_create(limit); }
 
+/******************************************************************************
+ *
+ * Name              : evq_setMode
+ *
+ * Description       : set the waiting mode of the event queue object
+ *
+ * Parameters
+ *   evq             : pointer to event queue object
+ *   mode            : waiting mode
+ *                     evqPrio: tasks are woken up in the priority order (default)
+ *                     evqFifo: tasks are woken up in the arrival order
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode, before any task waits for the event queue
+ *
+ ******************************************************************************/
+
+void evq_setMode( evq_t *evq, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : evq_kill
@@ -475,6 +574,7 @@ unsigned evq_pushISR( evq_t *evq, unsigned event ) { return evq_push(evq, event)
  * Constructor parameters
  *   limit           : size of a queue (max number of stored events)
  *   data            : event queue data buffer
+ *   mode            : waiting mode
  *
  * Note              : for internal use
  *
@@ -483,10 +583,11 @@ unsigned evq_pushISR( evq_t *evq, unsigned event ) { return evq_push(evq, event)
 struct baseEventQueue : public __evq
 {
 	 explicit
-	 baseEventQueue( const unsigned _limit, unsigned * const _data ): __evq _EVQ_INIT(_limit, _data) {}
+	 baseEventQueue( const unsigned _limit, unsigned * const _data, const unsigned _mode ): __evq _EVQ_INIT(_limit, _data, _mode) {}
 	~baseEventQueue( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )                          {        evq_kill     (this);                 }
+	void     setMode  ( unsigned _mode )                {        evq_setMode  (this, _mode);          }
 	unsigned waitFor  (                  cnt_t _delay ) { return evq_waitFor  (this,         _delay); }
 	unsigned waitUntil(                  cnt_t _time  ) { return evq_waitUntil(this,         _time);  }
 	unsigned wait     ( void )                          { return evq_wait     (this);                 }
@@ -509,6 +610,9 @@ struct baseEventQueue : public __evq
  *
  * Constructor parameters
  *   limit           : size of a queue (max number of stored events)
+ *   mode            : waiting mode
+ *                     evqPrio: tasks are woken up in the priority order (default)
+ *                     evqFifo: tasks are woken up in the arrival order
  *
  ******************************************************************************/
 
@@ -516,12 +620,31 @@ template<unsigned _limit>
 struct EventQueueT : public baseEventQueue
 {
 	explicit
-	EventQueueT( void ): baseEventQueue(_limit, data_) {}
+	EventQueueT( const unsigned _mode = evqPrio ): baseEventQueue(_limit, data_, _mode) {}
 
 	private:
 	unsigned data_[_limit];
 };
 
+/******************************************************************************
+ *
+ * Class             : EventQueuePow2
+ *
+ * Description       : create and initialize an event queue object with the capacity being a power of two
+ *
+ * Constructor parameters
+ *   limit           : size of a queue (max number of stored events)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit>
+struct EventQueuePow2T : public EventQueueT<_limit>
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+};
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -53,15 +53,24 @@ struct __mut
 	tsk_t  * queue; // next process in the DELAYED queue
 	void   * res;   // allocated fast mutex object's resource
 	tsk_t  * owner; // owner task
+	unsigned mode;  // fast mutex's release mode: mutHandoff or mutBarging
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define mutHandoff     ( 0U ) // the released mutex is handed over to the first waiting task (default)
+#define mutBarging     ( 1U ) // competitive release: the first waiting task is only woken up and has to compete for the mutex again
+
 /******************************************************************************
  *
  * Name              : _MUT_INIT
  *
  * Description       : create and initialize a fast mutex object
  *
- * Parameters        : none
+ * Parameters
+ *   mode            : fast mutex's release mode
+ *                     mutHandoff: the released mutex is handed over to the first waiting task (default)
+ *                     mutBarging: competitive release, the first waiting task is only woken up and has to compete for the mutex again
  *
  * Return            : fast mutex object
  *
@@ -69,7 +78,7 @@ struct __mut
  *
  ******************************************************************************/
 
-#define               _MUT_INIT() { 0, 0, 0 }
+#define               _MUT_INIT( _mode ) { 0, 0, 0, _mode }
 
 /******************************************************************************
  *
@@ -82,8 +91,8 @@ struct __mut
  *
  ******************************************************************************/
 
-#define             OS_MUT( mut )                     \
-                       mut_t mut##__mut = _MUT_INIT(); \
+#define             OS_MUT( mut )                                 \
+                       mut_t mut##__mut = _MUT_INIT( mutHandoff ); \
                        mut_id mut = & mut##__mut
 
 /******************************************************************************
@@ -97,8 +106,8 @@ struct __mut
  *
  ******************************************************************************/
 
-#define         static_MUT( mut )                     \
-                static mut_t mut##__mut = _MUT_INIT(); \
+#define         static_MUT( mut )                                 \
+                static mut_t mut##__mut = _MUT_INIT( mutHandoff ); \
                 static mut_id mut = & mut##__mut
 
 /******************************************************************************
@@ -117,7 +126,7 @@ struct __mut
 
 #ifndef __cplusplus
 #define                MUT_INIT() \
-                      _MUT_INIT()
+                      _MUT_INIT( mutHandoff )
 #endif
 
 /******************************************************************************
@@ -150,6 +159,9 @@ struct __mut
  *
  * Parameters
  *   mut             : pointer to fast mutex object
+ *   mode            : fast mutex's release mode
+ *                     mutHandoff: the released mutex is handed over to the first waiting task (default)
+ *                     mutBarging: competitive release, the first waiting task is only woken up and has to compete for the mutex again
  *
  * Return            : none
  *
@@ -157,7 +169,7 @@ struct __mut
  *
  ******************************************************************************/
 
-void mut_init( mut_t *mut );
+void mut_init( mut_t *mut, unsigned mode );
 
 /******************************************************************************
  *
@@ -337,14 +349,16 @@ unsigned mut_give( mut_t *mut );
  * Description       : create and initialize a fast mutex object
  *
  * Constructor parameters
- *                   : none
+ *   mode            : fast mutex's release mode
+ *                     mutHandoff: the released mutex is handed over to the first waiting task (default)
+ *                     mutBarging: competitive release, the first waiting task is only woken up and has to compete for the mutex again
  *
  ******************************************************************************/
 
 struct FastMutex : public __mut
 {
 	 explicit
-	 FastMutex( void ): __mut _MUT_INIT() {}
+	 FastMutex( const unsigned _mode = mutHandoff ): __mut _MUT_INIT(_mode) {}
 	~FastMutex( void ) { assert(owner == nullptr); }
 
 	void     kill     ( void )         {        mut_kill     (this);         }
@@ -53,12 +53,20 @@ struct __job
 	void   * res;   // allocated job queue object's resource
 	unsigned count; // inherited from semaphore
 	unsigned limit; // inherited from semaphore
+	unsigned mode;  // inherited from semaphore
 
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	fun_t ** data;  // data buffer
+
+	unsigned mask;  // index mask if the capacity is a power of two (free-running head and tail), otherwise zero
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define jobPrio      (  0U ) // waiting tasks are woken up in the priority order (default)
+#define jobFifo      (  1U ) // waiting tasks are woken up in the arrival order
+
 /******************************************************************************
  *
  * Name              : _JOB_INIT
@@ -68,6 +76,9 @@ struct __job
  * Parameters
  *   limit           : size of a queue (max number of stored job procedures)
  *   data            : job queue data buffer
+ *   mode            : waiting mode
+ *                     jobPrio: tasks are woken up in the priority order
+ *                     jobFifo: tasks are woken up in the arrival order
  *
  * Return            : job queue object
  *
@@ -75,7 +86,7 @@ struct __job
  *
  ******************************************************************************/
 
-#define               _JOB_INIT( _limit, _data ) { 0, 0, 0, _limit, 0, 0, _data }
+#define               _JOB_INIT( _limit, _data, _mode ) { 0, 0, 0, _limit, _mode, 0, 0, _data, POW2MASK( _limit ) }
 
 /******************************************************************************
  *
@@ -108,9 +119,9 @@ struct __job
  *
  ******************************************************************************/
 
-#define             OS_JOB( job, limit )                                 \
-                       fun_t *job##__buf[limit];                          \
-                       job_t  job##__job = _JOB_INIT( limit, job##__buf ); \
+#define             OS_JOB( job, limit )                                            \
+                       fun_t *job##__buf[limit];                                    \
+                       job_t  job##__job = _JOB_INIT( limit, job##__buf, jobPrio ); \
                        job_id job = & job##__job
 
 /******************************************************************************
@@ -125,11 +136,79 @@ struct __job
  *
  ******************************************************************************/
 
-#define         static_JOB( job, limit )                                 \
-                static fun_t *job##__buf[limit];                          \
-                static job_t  job##__job = _JOB_INIT( limit, job##__buf ); \
+#define         static_JOB( job, limit )                                            \
+                static fun_t *job##__buf[limit];                                    \
+                static job_t  job##__job = _JOB_INIT( limit, job##__buf, jobPrio ); \
+                static job_id job = & job##__job
+
+/******************************************************************************
+ *
+ * Name              : OS_JOB_FIFO
+ *
+ * Description       : define and initialize a job queue object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   job             : name of a pointer to job queue object
+ *   limit           : size of a queue (max number of stored job procedures)
+ *
+ ******************************************************************************/
+
+#define             OS_JOB_FIFO( job, limit )                                       \
+                       fun_t *job##__buf[limit];                                    \
+                       job_t  job##__job = _JOB_INIT( limit, job##__buf, jobFifo ); \
+                       job_id job = & job##__job
+
+/******************************************************************************
+ *
+ * Name              : static_JOB_FIFO
+ *
+ * Description       : define and initialize a static job queue object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   job             : name of a pointer to job queue object
+ *   limit           : size of a queue (max number of stored job procedures)
+ *
+ ******************************************************************************/
+
+#define         static_JOB_FIFO( job, limit )                                       \
+                static fun_t *job##__buf[limit];                                    \
+                static job_t  job##__job = _JOB_INIT( limit, job##__buf, jobFifo ); \
                 static job_id job = & job##__job
 
+/******************************************************************************
+ *
+ * Name              : OS_JOB_POW2
+ *
+ * Description       : define and initialize a job queue object with the capacity being a power of two
+ *
+ * Parameters
+ *   job             : name of a pointer to job queue object
+ *   limit           : size of a queue (max number of stored job procedures)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_JOB_POW2( job, limit ) \
+                    OS_JOB( job, POW2( limit ) )
+
+/******************************************************************************
+ *
+ * Name              : static_JOB_POW2
+ *
+ * Description       : define and initialize a static job queue object with the capacity being a power of two
+ *
+ * Parameters
+ *   job             : name of a pointer to job queue object
+ *   limit           : size of a queue (max number of stored job procedures)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_JOB_POW2( job, limit ) \
+                static_JOB( job, POW2( limit ) )
+
 /******************************************************************************
  *
  * Name              : JOB_INIT
@@ -147,7 +226,7 @@ struct __job
 
 #ifndef __cplusplus
 #define                JOB_INIT( limit ) \
-                      _JOB_INIT( limit, _JOB_DATA( limit ) )
+                      _JOB_INIT( limit, _JOB_DATA( limit ), jobPrio )
 #endif
 
 /******************************************************************************
@@ -214,6 +293,26 @@ job_t *job_create( unsigned limit );
 __STATIC_INLINE
 job_t *job_new( unsigned limit ) { return job_create(limit); }
 
+/******************************************************************************
+ *
+ * Name              : job_setMode
+ *
+ * Description       : set the waiting mode of the job queue object
+ *
+ * Parameters
+ *   job             : pointer to job queue object
+ *   mode            : waiting mode
+ *                     jobPrio: tasks are woken up in the priority order (default)
+ *                     jobFifo: tasks are woken up in the arrival order
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode, before any task waits for the job queue
+ *
+ ******************************************************************************/
+
+void job_setMode( job_t *job, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : job_kill
@@ -476,6 +575,7 @@ unsigned job_pushISR( job_t *job, fun_t *fun ) { return job_push(job, fun); }
  * Constructor parameters
  *   limit           : size of a queue (max number of stored job procedures)
  *   data            : job queue data buffer
+ *   mode            : waiting mode
  *
  * Note              : for internal use
  *
@@ -486,10 +586,11 @@ unsigned job_pushISR( job_t *job, fun_t *fun ) { return job_push(job, fun); }
 struct baseJobQueue : public __box
 {
 	 explicit
-	 baseJobQueue( const unsigned _limit, FUN_t * const _data ): __box _BOX_INIT( _limit, reinterpret_cast<char *>(_data), sizeof(FUN_t) ) {}
+	 baseJobQueue( const unsigned _limit, FUN_t * const _data, const unsigned _mode ): __box _BOX_INIT( _limit, reinterpret_cast<char *>(_data), sizeof(FUN_t), _mode ) {}
 	~baseJobQueue( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )                     {                              box_kill     (this);                                                              }
+	void     setMode  ( unsigned _mode )           {                              box_setMode  (this, _mode);                                                       }
 	unsigned waitFor  ( cnt_t _delay )             { FUN_t _fun; unsigned event = box_waitFor  (this, &_fun, _delay); if (event == E_SUCCESS) _fun(); return event; }
 	unsigned waitUntil( cnt_t _time )              { FUN_t _fun; unsigned event = box_waitUntil(this, &_fun, _time);  if (event == E_SUCCESS) _fun(); return event; }
 	unsigned wait     ( void )                     { FUN_t _fun; unsigned event = box_wait     (this, &_fun);         if (event == E_SUCCESS) _fun(); return event; }
@@ -508,10 +609,11 @@ struct baseJobQueue : public __box
 struct baseJobQueue : public __job
 {
 	 explicit
-	 baseJobQueue( const unsigned _limit, FUN_t * const _data ): __job _JOB_INIT( _limit, _data ) {}
+	 baseJobQueue( const unsigned _limit, FUN_t * const _data, const unsigned _mode ): __job _JOB_INIT( _limit, _data, _mode ) {}
 	~baseJobQueue( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )                     {        job_kill     (this);               }
+	void     setMode  ( unsigned _mode )           {        job_setMode  (this, _mode);        }
 	unsigned waitFor  ( cnt_t _delay )             { return job_waitFor  (this, _delay);       }
 	unsigned waitUntil( cnt_t _time )              { return job_waitUntil(this, _time);        }
 	unsigned wait     ( void )                     { return job_wait     (this);               }
@@ -535,6 +637,9 @@ struct baseJobQueue : public __job
  *
  * Constructor parameters
  *   limit           : size of a queue (max number of stored job procedures)
+ *   mode            : waiting mode
+ *                     jobPrio: tasks are woken up in the priority order (default)
+ *                     jobFifo: tasks are woken up in the arrival order
  *
  ******************************************************************************/
 
@@ -542,12 +647,31 @@ template<unsigned _limit>
 struct JobQueueT : public baseJobQueue
 {
 	explicit
-	JobQueueT( void ): baseJobQueue(_limit, data_) {}
+	JobQueueT( const unsigned _mode = jobPrio ): baseJobQueue(_limit, data_, _mode) {}
 
 	private:
 	FUN_t data_[_limit];
 };
 
+/******************************************************************************
+ *
+ * Class             : JobQueuePow2
+ *
+ * Description       : create and initialize a job queue object with the capacity being a power of two
+ *
+ * Constructor parameters
+ *   limit           : size of a queue (max number of stored job procedures)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit>
+struct JobQueuePow2T : public JobQueueT<_limit>
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+};
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -58,8 +58,16 @@ struct __box
 	char   * data;  // inherited from stream buffer
 
 	unsigned size;  // size of a single mail (in bytes)
+	unsigned mode;  // waiting mode: boxPrio or boxFifo
+
+	unsigned mask;  // index mask if the capacity is a power of two (free-running head and tail), otherwise zero
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define boxPrio      (  0U ) // waiting tasks are woken up in the priority order (default)
+#define boxFifo      (  1U ) // waiting tasks are woken up in the arrival order
+
 /******************************************************************************
  *
  * Name              : _BOX_INIT
@@ -70,6 +78,9 @@ struct __box
  *   limit           : size of a queue (max number of stored mails)
  *   data            : mailbox queue data buffer
  *   size            : size of a single mail (in bytes)
+ *   mode            : waiting mode
+ *                     boxPrio: tasks are woken up in the priority order
+ *                     boxFifo: tasks are woken up in the arrival order
  *
  * Return            : mailbox queue object
  *
@@ -77,7 +88,7 @@ struct __box
  *
  ******************************************************************************/
 
-#define               _BOX_INIT( _limit, _data, _size ) { 0, 0, 0, _limit * _size, 0, 0, _data, _size }
+#define               _BOX_INIT( _limit, _data, _size, _mode ) { 0, 0, 0, _limit * _size, 0, 0, _data, _size, _mode, POW2MASK( _limit ) }
 
 /******************************************************************************
  *
@@ -112,9 +123,9 @@ struct __box
  *
  ******************************************************************************/
 
-#define             OS_BOX( box, limit, size )                                \
-                       char box##__buf[limit*size];                            \
-                       box_t box##__box = _BOX_INIT( limit, box##__buf, size ); \
+#define             OS_BOX( box, limit, size )                                           \
+                       char box##__buf[limit*size];                                      \
+                       box_t box##__box = _BOX_INIT( limit, box##__buf, size, boxPrio ); \
                        box_id box = & box##__box
 
 /******************************************************************************
@@ -130,11 +141,83 @@ struct __box
  *
  ******************************************************************************/
 
-#define         static_BOX( box, limit, size )                                \
-                static char box##__buf[limit*size];                            \
-                static box_t box##__box = _BOX_INIT( limit, box##__buf, size ); \
+#define         static_BOX( box, limit, size )                                           \
+                static char box##__buf[limit*size];                                      \
+                static box_t box##__box = _BOX_INIT( limit, box##__buf, size, boxPrio ); \
+                static box_id box = & box##__box
+
+/******************************************************************************
+ *
+ * Name              : OS_BOX_FIFO
+ *
+ * Description       : define and initialize a mailbox queue object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   box             : name of a pointer to mailbox queue object
+ *   limit           : size of a queue (max number of stored mails)
+ *   size            : size of a single mail (in bytes)
+ *
+ ******************************************************************************/
+
+#define             OS_BOX_FIFO( box, limit, size )                                      \
+                       char box##__buf[limit*size];                                      \
+                       box_t box##__box = _BOX_INIT( limit, box##__buf, size, boxFifo ); \
+                       box_id box = & box##__box
+
+/******************************************************************************
+ *
+ * Name              : static_BOX_FIFO
+ *
+ * Description       : define and initialize a static mailbox queue object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   box             : name of a pointer to mailbox queue object
+ *   limit           : size of a queue (max number of stored mails)
+ *   size            : size of a single mail (in bytes)
+ *
+ ******************************************************************************/
+
+#define         static_BOX_FIFO( box, limit, size )                                      \
+                static char box##__buf[limit*size];                                      \
+                static box_t box##__box = _BOX_INIT( limit, box##__buf, size, boxFifo ); \
                 static box_id box = & box##__box
 
+/******************************************************************************
+ *
+ * Name              : OS_BOX_POW2
+ *
+ * Description       : define and initialize a mailbox queue object with the capacity being a power of two
+ *
+ * Parameters
+ *   box             : name of a pointer to mailbox queue object
+ *   limit           : size of a queue (max number of stored mails)
+ *   size            : size of a single mail (in bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_BOX_POW2( box, limit, size ) \
+                    OS_BOX( box, POW2( limit ), size )
+
+/******************************************************************************
+ *
+ * Name              : static_BOX_POW2
+ *
+ * Description       : define and initialize a static mailbox queue object with the capacity being a power of two
+ *
+ * Parameters
+ *   box             : name of a pointer to mailbox queue object
+ *   limit           : size of a queue (max number of stored mails)
+ *   size            : size of a single mail (in bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_BOX_POW2( box, limit, size ) \
+                static_BOX( box, POW2( limit ), size )
+
 /******************************************************************************
  *
  * Name              : BOX_INIT
@@ -153,7 +236,7 @@ struct __box
 
 #ifndef __cplusplus
 #define                BOX_INIT( limit, size ) \
-                      _BOX_INIT( limit, _BOX_DATA( limit, size ), size )
+                      _BOX_INIT( limit, _BOX_DATA( limit, size ), size, boxPrio )
 #endif
 
 /******************************************************************************
@@ -223,6 +306,26 @@ box_t *box_create( unsigned limit, unsigned size );
 __STATIC_INLINE
 box_t *box_new( unsigned limit, unsigned size ) { return box_create(limit, size); }
 
+/******************************************************************************
+ *
+ * Name              : box_setMode
+ *
+ * Description       : set the waiting mode of the mailbox queue object
+ *
+ * Parameters
+ *   box             : pointer to mailbox queue object
+ *   mode            : waiting mode
+ *                     boxPrio: tasks are woken up in the priority order (default)
+ *                     boxFifo: tasks are woken up in the arrival order
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode, before any task waits for the mailbox queue
+ *
+ ******************************************************************************/
+
+void box_setMode( box_t *box, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : box_kill
@@ -528,6 +631,7 @@ unsigned box_spaceISR( box_t *box ) { return box_space(box); }
  *   limit           : size of a queue (max number of stored mails)
  *   data            : mailbox queue data buffer
  *   size            : size of a single mail (in bytes)
+ *   mode            : waiting mode
  *
  * Note              : for internal use
  *
@@ -536,10 +640,11 @@ unsigned box_spaceISR( box_t *box ) { return box_space(box); }
 struct baseMailBoxQueue : public __box
 {
 	 explicit
-	 baseMailBoxQueue( const unsigned _limit, char * const _data, const unsigned _size ): __box _BOX_INIT(_limit, _data, _size) {}
+	 baseMailBoxQueue( const unsigned _limit, char * const _data, const unsigned _size, const unsigned _mode ): __box _BOX_INIT(_limit, _data, _size, _mode) {}
 	~baseMailBoxQueue( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )                            {        box_kill     (this);                }
+	void     setMode  ( unsigned _mode )                  {        box_setMode  (this, _mode);         }
 	unsigned waitFor  (       void *_data, cnt_t _delay ) { return box_waitFor  (this, _data, _delay); }
 	unsigned waitUntil(       void *_data, cnt_t _time  ) { return box_waitUntil(this, _data, _time);  }
 	unsigned wait     (       void *_data )               { return box_wait     (this, _data);         }
@@ -567,6 +672,9 @@ struct baseMailBoxQueue : public __box
  * Constructor parameters
  *   limit           : size of a queue (max number of stored mails)
  *   size            : size of a single mail (in bytes)
+ *   mode            : waiting mode
+ *                     boxPrio: tasks are woken up in the priority order (default)
+ *                     boxFifo: tasks are woken up in the arrival order
  *
  ******************************************************************************/
 
@@ -574,7 +682,7 @@ template<unsigned _limit, unsigned _size>
 struct MailBoxQueueT : public baseMailBoxQueue
 {
 	explicit
-	MailBoxQueueT( void ): baseMailBoxQueue(_limit, data_, _size) {}
+	MailBoxQueueT( const unsigned _mode = boxPrio ): baseMailBoxQueue(_limit, data_, _size, _mode) {}
 
 	private:
 	char data_[_limit * _size];
@@ -589,6 +697,9 @@ struct MailBoxQueueT : public baseMailBoxQueue
  * Constructor parameters
  *   limit           : size of a queue (max number of stored mails)
  *   T               : class of a single mail
+ *   mode            : waiting mode
+ *                     boxPrio: tasks are woken up in the priority order (default)
+ *                     boxFifo: tasks are woken up in the arrival order
  *
  ******************************************************************************/
 
@@ -596,12 +707,32 @@ template<unsigned _limit, class T>
 struct MailBoxQueueTT : public baseMailBoxQueue
 {
 	explicit
-	MailBoxQueueTT( void ): baseMailBoxQueue(_limit, reinterpret_cast<char *>(data_), sizeof(T)) {}
+	MailBoxQueueTT( const unsigned _mode = boxPrio ): baseMailBoxQueue(_limit, reinterpret_cast<char *>(data_), sizeof(T), _mode) {}
 
 	private:
 	T data_[_limit];
 };
 
+/******************************************************************************
+ *
+ * Class             : MailBoxQueuePow2
+ *
+ * Description       : create and initialize a mailbox queue object with the capacity being a power of two
+ *
+ * Constructor parameters
+ *   limit           : size of a queue (max number of stored mails)
+ *   size            : size of a single mail (in bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit, unsigned _size>
+struct MailBoxQueuePow2T : public MailBoxQueueT<_limit, _size>
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+};
+
 #endif
 
 /* -------------------------------------------------------------------------- */
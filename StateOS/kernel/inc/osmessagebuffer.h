@@ -58,8 +58,16 @@ struct __msg
 	char   * data;  // inherited from stream buffer
 
 	unsigned size;  // size of the first message in the buffer
+
+	unsigned mask;  // index mask if the capacity is a power of two (free-running head and tail), otherwise zero
+	unsigned mode;  // message buffer mode: msgNormal or msgSPSC
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define msgNormal    ( 0U ) // message buffer object used by any number of tasks (default)
+#define msgSPSC      ( 1U ) // only the single-producer/single-consumer functions are used, the capacity is a power of two
+
 /******************************************************************************
  *
  * Name              : _MSG_INIT
@@ -69,6 +77,9 @@ struct __msg
  * Parameters
  *   limit           : size of a buffer (max number of stored bytes)
  *   data            : message buffer data
+ *   mode            : message buffer mode
+ *                     msgNormal: message buffer object used by any number of tasks
+ *                     msgSPSC:   only the single-producer/single-consumer functions are used
  *
  * Return            : message buffer object
  *
@@ -76,7 +87,7 @@ struct __msg
  *
  ******************************************************************************/
 
-#define               _MSG_INIT( _limit, _data ) { 0, 0, 0, _limit, 0, 0, _data, 0 }
+#define               _MSG_INIT( _limit, _data, _mode ) { 0, 0, 0, _limit, 0, 0, _data, 0, POW2MASK( _limit ), _mode }
 
 /******************************************************************************
  *
@@ -111,7 +122,7 @@ struct __msg
 
 #define             OS_MSG( msg, limit )                                \
                        char msg##__buf[limit];                           \
-                       msg_t msg##__msg = _MSG_INIT( limit, msg##__buf ); \
+                       msg_t msg##__msg = _MSG_INIT( limit, msg##__buf, msgNormal ); \
                        msg_id msg = & msg##__msg
 
 /******************************************************************************
@@ -128,7 +139,79 @@ struct __msg
 
 #define         static_MSG( msg, limit )                                \
                 static char msg##__buf[limit];                           \
-                static msg_t msg##__msg = _MSG_INIT( limit, msg##__buf ); \
+                static msg_t msg##__msg = _MSG_INIT( limit, msg##__buf, msgNormal ); \
+                static msg_id msg = & msg##__msg
+
+/******************************************************************************
+ *
+ * Name              : OS_MSG_POW2
+ *
+ * Description       : define and initialize a message buffer object with the capacity being a power of two
+ *
+ * Parameters
+ *   msg             : name of a pointer to message buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_MSG_POW2( msg, limit ) \
+                    OS_MSG( msg, POW2( limit ) )
+
+/******************************************************************************
+ *
+ * Name              : static_MSG_POW2
+ *
+ * Description       : define and initialize a static message buffer object with the capacity being a power of two
+ *
+ * Parameters
+ *   msg             : name of a pointer to message buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_MSG_POW2( msg, limit ) \
+                static_MSG( msg, POW2( limit ) )
+
+/******************************************************************************
+ *
+ * Name              : OS_MSG_SPSC
+ *
+ * Description       : define and initialize a message buffer object in the msgSPSC mode
+ *
+ * Parameters
+ *   msg             : name of a pointer to message buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_MSG_SPSC( msg, limit )                                            \
+                       char msg##__buf[POW2( limit )];                                    \
+                       msg_t msg##__msg = _MSG_INIT( POW2( limit ), msg##__buf, msgSPSC ); \
+                       msg_id msg = & msg##__msg
+
+/******************************************************************************
+ *
+ * Name              : static_MSG_SPSC
+ *
+ * Description       : define and initialize a static message buffer object in the msgSPSC mode
+ *
+ * Parameters
+ *   msg             : name of a pointer to message buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_MSG_SPSC( msg, limit )                                            \
+                static char msg##__buf[POW2( limit )];                                    \
+                static msg_t msg##__msg = _MSG_INIT( POW2( limit ), msg##__buf, msgSPSC ); \
                 static msg_id msg = & msg##__msg
 
 /******************************************************************************
@@ -148,7 +231,7 @@ struct __msg
 
 #ifndef __cplusplus
 #define                MSG_INIT( limit ) \
-                      _MSG_INIT( limit, _MSG_DATA( limit ) )
+                      _MSG_INIT( limit, _MSG_DATA( limit ), msgNormal )
 #endif
 
 /******************************************************************************
@@ -215,6 +298,27 @@ msg_t *msg_create( unsigned limit );
 __STATIC_INLINE
 msg_t *msg_new( unsigned limit ) { return msg_create(limit); }
 
+/******************************************************************************
+ *
+ * Name              : msg_setMode
+ *
+ * Description       : set the mode of the message buffer object
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   mode            : message buffer mode
+ *                     msgNormal: message buffer object used by any number of tasks (default)
+ *                     msgSPSC:   only the single-producer/single-consumer functions are used
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode, while the message buffer is empty
+ *                     the capacity of the message buffer must be a power of two for the msgSPSC mode
+ *
+ ******************************************************************************/
+
+void msg_setMode( msg_t *msg, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : msg_kill
@@ -452,6 +556,192 @@ unsigned msg_push( msg_t *msg, const void *data, unsigned size );
 __STATIC_INLINE
 unsigned msg_pushISR( msg_t *msg, const void *data, unsigned size ) { return msg_push(msg, data, size); }
 
+/******************************************************************************
+ *
+ * Name              : msg_waitSPSCFor
+ *
+ * Description       : try to transfer data from the message buffer object,
+ *                     wait for given duration of time while the message buffer object is empty
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *   delay           : duration of time (maximum number of ticks to wait while the message buffer object is empty)
+ *                     IMMEDIATE: don't wait if the message buffer object is empty
+ *                     INFINITE:  wait indefinitely while the message buffer object is empty
+ *
+ * Return            : number of bytes read from the message buffer
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned msg_waitSPSCFor( msg_t *msg, void *data, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : msg_waitSPSCUntil
+ *
+ * Description       : try to transfer data from the message buffer object,
+ *                     wait until given timepoint while the message buffer object is empty
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *   time            : timepoint value
+ *
+ * Return            : number of bytes read from the message buffer
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned msg_waitSPSCUntil( msg_t *msg, void *data, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : msg_waitSPSC
+ *
+ * Description       : try to transfer data from the message buffer object,
+ *                     wait indefinitely while the message buffer object is empty
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *
+ * Return            : number of bytes read from the message buffer
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned msg_waitSPSC( msg_t *msg, void *data, unsigned size ) { return msg_waitSPSCFor(msg, data, size, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : msg_takeSPSC
+ * ISR alias         : msg_takeSPSCISR
+ *
+ * Description       : try to transfer data from the message buffer object,
+ *                     don't wait if the message buffer object is empty
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *
+ * Return            : number of bytes read from the message buffer
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned msg_takeSPSC( msg_t *msg, void *data, unsigned size );
+
+__STATIC_INLINE
+unsigned msg_takeSPSCISR( msg_t *msg, void *data, unsigned size ) { return msg_takeSPSC(msg, data, size); }
+
+/******************************************************************************
+ *
+ * Name              : msg_sendSPSCFor
+ *
+ * Description       : try to transfer data to the message buffer object,
+ *                     wait for given duration of time while the message buffer object is full
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *   delay           : duration of time (maximum number of ticks to wait while the message buffer object is full)
+ *                     IMMEDIATE: don't wait if the message buffer object is full
+ *                     INFINITE:  wait indefinitely while the message buffer object is full
+ *
+ * Return            : number of bytes written to the message buffer
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned msg_sendSPSCFor( msg_t *msg, const void *data, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : msg_sendSPSCUntil
+ *
+ * Description       : try to transfer data to the message buffer object,
+ *                     wait until given timepoint while the message buffer object is full
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *   time            : timepoint value
+ *
+ * Return            : number of bytes written to the message buffer
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned msg_sendSPSCUntil( msg_t *msg, const void *data, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : msg_sendSPSC
+ *
+ * Description       : try to transfer data to the message buffer object,
+ *                     wait indefinitely while the message buffer object is full
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *
+ * Return            : number of bytes written to the message buffer
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned msg_sendSPSC( msg_t *msg, const void *data, unsigned size ) { return msg_sendSPSCFor(msg, data, size, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : msg_giveSPSC
+ * ISR alias         : msg_giveSPSCISR
+ *
+ * Description       : try to transfer data to the message buffer object,
+ *                     don't wait if the message buffer object is full
+ *
+ * Parameters
+ *   msg             : pointer to message buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *
+ * Return            : number of bytes written to the message buffer
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     single-producer/single-consumer function, use only for the message buffer object in the msgSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned msg_giveSPSC( msg_t *msg, const void *data, unsigned size );
+
+__STATIC_INLINE
+unsigned msg_giveSPSCISR( msg_t *msg, const void *data, unsigned size ) { return msg_giveSPSC(msg, data, size); }
+
 /******************************************************************************
  *
  * Name              : msg_count
@@ -515,10 +805,11 @@ unsigned msg_spaceISR( msg_t *msg ) { return msg_space(msg); }
 struct baseMessageBuffer : public __msg
 {
 	 explicit
-	 baseMessageBuffer( const unsigned _limit, char * const _data ): __msg _MSG_INIT(_limit, _data) {}
+	 baseMessageBuffer( const unsigned _limit, char * const _data, const unsigned _mode = msgNormal ): __msg _MSG_INIT(_limit, _data, _mode) {}
 	~baseMessageBuffer( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )                                            {        msg_kill     (this);                       }
+	void     setMode  ( unsigned _mode )                                  {        msg_setMode  (this, _mode);                }
 	unsigned waitFor  (       void *_data, unsigned _size, cnt_t _delay ) { return msg_waitFor  (this, _data, _size, _delay); }
 	unsigned waitUntil(       void *_data, unsigned _size, cnt_t _time  ) { return msg_waitUntil(this, _data, _size, _time);  }
 	unsigned wait     (       void *_data, unsigned _size )               { return msg_wait     (this, _data, _size);         }
@@ -531,6 +822,16 @@ struct baseMessageBuffer : public __msg
 	unsigned giveISR  ( const void *_data, unsigned _size )               { return msg_giveISR  (this, _data, _size);         }
 	unsigned push     ( const void *_data, unsigned _size )               { return msg_push     (this, _data, _size);         }
 	unsigned pushISR  ( const void *_data, unsigned _size )               { return msg_pushISR  (this, _data, _size);         }
+	unsigned waitSPSCFor  (       void *_data, unsigned _size, cnt_t _delay ) { return msg_waitSPSCFor  (this, _data, _size, _delay); }
+	unsigned waitSPSCUntil(       void *_data, unsigned _size, cnt_t _time  ) { return msg_waitSPSCUntil(this, _data, _size, _time);  }
+	unsigned waitSPSC     (       void *_data, unsigned _size )               { return msg_waitSPSC     (this, _data, _size);         }
+	unsigned takeSPSC     (       void *_data, unsigned _size )               { return msg_takeSPSC     (this, _data, _size);         }
+	unsigned takeSPSCISR  (       void *_data, unsigned _size )               { return msg_takeSPSCISR  (this, _data, _size);         }
+	unsigned sendSPSCFor  ( const void *_data, unsigned _size, cnt_t _delay ) { return msg_sendSPSCFor  (this, _data, _size, _delay); }
+	unsigned sendSPSCUntil( const void *_data, unsigned _size, cnt_t _time  ) { return msg_sendSPSCUntil(this, _data, _size, _time);  }
+	unsigned sendSPSC     ( const void *_data, unsigned _size )               { return msg_sendSPSC     (this, _data, _size);         }
+	unsigned giveSPSC     ( const void *_data, unsigned _size )               { return msg_giveSPSC     (this, _data, _size);         }
+	unsigned giveSPSCISR  ( const void *_data, unsigned _size )               { return msg_giveSPSCISR  (this, _data, _size);         }
 	unsigned count    ( void )                                            { return msg_count    (this);                       }
 	unsigned countISR ( void )                                            { return msg_countISR (this);                       }
 	unsigned space    ( void )                                            { return msg_space    (this);                       }
@@ -580,6 +881,50 @@ struct MessageBufferTT : public baseMessageBuffer
 	char data_[_limit*(sizeof(unsigned)+sizeof(T))-sizeof(unsigned)];
 };
 
+/******************************************************************************
+ *
+ * Class             : MessageBufferPow2
+ *
+ * Description       : create and initialize a message buffer object with the capacity being a power of two
+ *
+ * Constructor parameters
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit>
+struct MessageBufferPow2T : public MessageBufferT<_limit>
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+};
+
+/******************************************************************************
+ *
+ * Class             : MessageBufferSPSC
+ *
+ * Description       : create and initialize a message buffer object in the msgSPSC mode
+ *
+ * Constructor parameters
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit>
+struct MessageBufferSPSCT : public baseMessageBuffer
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+
+	explicit
+	MessageBufferSPSCT( void ): baseMessageBuffer(_limit, data_, msgSPSC) {}
+
+	private:
+	char data_[_limit];
+};
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -45,8 +45,6 @@ extern "C" {
  *
  ******************************************************************************/
 
-typedef struct __mtx mtx_t, * const mtx_id;
-
 struct __mtx
 {
 	tsk_t  * queue; // next process in the DELAYED queue
@@ -54,15 +52,29 @@ struct __mtx
 	tsk_t  * owner; // owner task
 	unsigned count; // mutex's curent value
 	mtx_t  * list;  // list of mutexes held by owner
+	unsigned mode;  // mutex's protocol: mtxPrioInherit or mtxPrioProtect, optionally with mtxBarging
+	unsigned prio;  // priority ceiling (used only with mtxPrioProtect protocol)
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define mtxPrioInherit ( 0U ) // priority inheritance protocol (default)
+#define mtxPrioProtect ( 1U ) // immediate priority ceiling protocol: the owner runs at the priority ceiling of the mutex
+#define mtxBarging     ( 2U ) // competitive release: the first waiting task is only woken up and has to compete for the mutex again
+
 /******************************************************************************
  *
  * Name              : _MTX_INIT
  *
  * Description       : create and initialize a mutex object
  *
- * Parameters        : none
+ * Parameters
+ *   mode            : mutex's protocol
+ *                     mtxPrioInherit: priority inheritance protocol (default)
+ *                     mtxPrioProtect: immediate priority ceiling protocol
+ *                     mtxBarging: competitive release (can be combined with the above using '|' operator),
+ *                                 the released mutex is not handed over to the first waiting task
+ *   prio            : priority ceiling (used only with mtxPrioProtect protocol)
  *
  * Return            : mutex object
  *
@@ -70,7 +82,7 @@ struct __mtx
  *
  ******************************************************************************/
 
-#define               _MTX_INIT() { 0, 0, 0, 0, 0 }
+#define               _MTX_INIT( _mode, _prio ) { 0, 0, 0, 0, 0, _mode, _prio }
 
 /******************************************************************************
  *
@@ -83,8 +95,8 @@ struct __mtx
  *
  ******************************************************************************/
 
-#define             OS_MTX( mtx )                     \
-                       mtx_t mtx##__mtx = _MTX_INIT(); \
+#define             OS_MTX( mtx )                                        \
+                       mtx_t mtx##__mtx = _MTX_INIT( mtxPrioInherit, 0 ); \
                        mtx_id mtx = & mtx##__mtx
 
 /******************************************************************************
@@ -98,8 +110,8 @@ struct __mtx
  *
  ******************************************************************************/
 
-#define         static_MTX( mtx )                     \
-                static mtx_t mtx##__mtx = _MTX_INIT(); \
+#define         static_MTX( mtx )                                        \
+                static mtx_t mtx##__mtx = _MTX_INIT( mtxPrioInherit, 0 ); \
                 static mtx_id mtx = & mtx##__mtx
 
 /******************************************************************************
@@ -118,7 +130,7 @@ struct __mtx
 
 #ifndef __cplusplus
 #define                MTX_INIT() \
-                      _MTX_INIT()
+                      _MTX_INIT( mtxPrioInherit, 0 )
 #endif
 
 /******************************************************************************
@@ -151,6 +163,13 @@ struct __mtx
  *
  * Parameters
  *   mtx             : pointer to mutex object
+ *   mode            : mutex's protocol
+ *                     mtxPrioInherit: priority inheritance protocol
+ *                     mtxPrioProtect: immediate priority ceiling protocol
+ *                     mtxBarging: competitive release (can be combined with the above using '|' operator),
+ *                                 the released mutex is not handed over to the first waiting task
+ *   prio            : priority ceiling (used only with mtxPrioProtect protocol),
+ *                     must not be lower than the priority of any task using the mutex
  *
  * Return            : none
  *
@@ -158,7 +177,7 @@ struct __mtx
  *
  ******************************************************************************/
 
-void mtx_init( mtx_t *mtx );
+void mtx_init( mtx_t *mtx, unsigned mode, unsigned prio );
 
 /******************************************************************************
  *
@@ -338,14 +357,19 @@ unsigned mtx_give( mtx_t *mtx );
  * Description       : create and initialize a mutex object
  *
  * Constructor parameters
- *                   : none
+ *   mode            : mutex's protocol
+ *                     mtxPrioInherit: priority inheritance protocol (default)
+ *                     mtxPrioProtect: immediate priority ceiling protocol
+ *                     mtxBarging: competitive release (can be combined with the above using '|' operator),
+ *                                 the released mutex is not handed over to the first waiting task
+ *   prio            : priority ceiling (used only with mtxPrioProtect protocol)
  *
  ******************************************************************************/
 
 struct Mutex : public __mtx
 {
 	 explicit
-	 Mutex( void ): __mtx _MTX_INIT() {}
+	 Mutex( const unsigned _mode = mtxPrioInherit, const unsigned _prio = 0 ): __mtx _MTX_INIT(_mode, _prio) {}
 	~Mutex( void ) { assert(owner == nullptr); }
 
 	void     kill     ( void )         {        mtx_kill     (this);         }
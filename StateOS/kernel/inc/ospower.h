@@ -0,0 +1,385 @@
+/******************************************************************************
+
+    @file    StateOS: ospower.h
+    @author  Rajmund Szymanski
+    @date    03.08.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_PWR_H
+#define __STATEOS_PWR_H
+
+#include "oskernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : low-power idle state
+ *
+ ******************************************************************************/
+
+typedef cnt_t fun_pwr_enter( cnt_t );
+typedef void  fun_pwr_leave( void );
+
+struct __pwr
+{
+	pwr_t  * next;      // next registered idle state (sorted by latency)
+	cnt_t    latency;   // wakeup latency of the idle state (in ticks)
+	cnt_t    residency; // minimal idle time (in ticks) for which entering the idle state pays off
+	fun_pwr_enter *enter; // entry procedure: enter the idle state for at most given number of ticks
+	fun_pwr_leave *leave; // exit procedure: restore the system (e.g. clocks) after wakeup; may be zero
+	unsigned count;     // statistics: number of entries to the idle state
+	cnt_t    time;      // statistics: time (in ticks) spent in the idle state
+};
+
+/******************************************************************************
+ *
+ * Name              : latency budget request
+ *
+ ******************************************************************************/
+
+typedef struct __lat lat_t, * const lat_id;
+
+struct __lat
+{
+	lat_t  * next;      // next registered request
+	cnt_t    budget;    // acceptable wakeup latency (in ticks)
+};
+
+/******************************************************************************
+ *
+ * Name              : _PWR_INIT
+ *
+ * Description       : create and initialize a low-power idle state object
+ *
+ * Parameters
+ *   latency         : wakeup latency of the idle state (in ticks)
+ *   residency       : minimal idle time (in ticks) for which entering the idle state pays off
+ *   enter           : entry procedure
+ *   leave           : exit procedure
+ *
+ * Return            : low-power idle state object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _PWR_INIT( _latency, _residency, _enter, _leave ) { 0, _latency, _residency, _enter, _leave, 0, 0 }
+
+/******************************************************************************
+ *
+ * Name              : OS_PWR
+ *
+ * Description       : define and initialize a low-power idle state object
+ *
+ * Parameters
+ *   pwr             : name of a pointer to low-power idle state object
+ *   latency         : wakeup latency of the idle state (in ticks)
+ *   residency       : minimal idle time (in ticks) for which entering the idle state pays off
+ *   enter           : entry procedure
+ *   leave           : exit procedure
+ *
+ ******************************************************************************/
+
+#define             OS_PWR( pwr, latency, residency, enter, leave )                     \
+                       pwr_t pwr##__pwr = _PWR_INIT( latency, residency, enter, leave ); \
+                       pwr_id pwr = & pwr##__pwr
+
+/******************************************************************************
+ *
+ * Name              : static_PWR
+ *
+ * Description       : define and initialize a static low-power idle state object
+ *
+ * Parameters
+ *   pwr             : name of a pointer to low-power idle state object
+ *   latency         : wakeup latency of the idle state (in ticks)
+ *   residency       : minimal idle time (in ticks) for which entering the idle state pays off
+ *   enter           : entry procedure
+ *   leave           : exit procedure
+ *
+ ******************************************************************************/
+
+#define         static_PWR( pwr, latency, residency, enter, leave )                     \
+                static pwr_t pwr##__pwr = _PWR_INIT( latency, residency, enter, leave ); \
+                static pwr_id pwr = & pwr##__pwr
+
+/******************************************************************************
+ *
+ * Name              : PWR_INIT
+ *
+ * Description       : create and initialize a low-power idle state object
+ *
+ * Parameters
+ *   latency         : wakeup latency of the idle state (in ticks)
+ *   residency       : minimal idle time (in ticks) for which entering the idle state pays off
+ *   enter           : entry procedure
+ *   leave           : exit procedure
+ *
+ * Return            : low-power idle state object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                PWR_INIT( latency, residency, enter, leave ) \
+                      _PWR_INIT( latency, residency, enter, leave )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : pwr_init
+ *
+ * Description       : initialize a low-power idle state object
+ *
+ * Parameters
+ *   pwr             : pointer to low-power idle state object
+ *   latency         : wakeup latency of the idle state (in ticks)
+ *   residency       : minimal idle time (in ticks) for which entering the idle state pays off
+ *   enter           : entry procedure, called by the idle task with interrupts disabled;
+ *                     it gets the number of ticks to the nearest timer expiration (INFINITE: none),
+ *                     should wait for interrupt and return the number of elapsed ticks
+ *                     the system timer counter must be advanced by (non-tick-less mode only)
+ *   leave           : exit procedure, called with interrupts still disabled; may be zero
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     an idle state object being registered is unregistered first
+ *
+ ******************************************************************************/
+
+void pwr_init( pwr_t *pwr, cnt_t latency, cnt_t residency, fun_pwr_enter *enter, fun_pwr_leave *leave );
+
+/******************************************************************************
+ *
+ * Name              : pwr_register
+ *
+ * Description       : add the low-power idle state to the idle policy
+ *                     the idle task enters the deepest registered state whose latency fits
+ *                     the current latency budget and whose residency fits the time to the nearest timer expiration
+ *                     if there is no such state, the idle task waits for interrupt in the default way
+ *
+ * Parameters
+ *   pwr             : pointer to low-power idle state object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pwr_register( pwr_t *pwr );
+
+/******************************************************************************
+ *
+ * Name              : pwr_unregister
+ *
+ * Description       : remove the low-power idle state from the idle policy
+ *
+ * Parameters
+ *   pwr             : pointer to low-power idle state object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pwr_unregister( pwr_t *pwr );
+
+/******************************************************************************
+ *
+ * Name              : pwr_require
+ *
+ * Description       : register (or update) the latency budget request
+ *                     the current latency budget is the smallest of all registered requests
+ *
+ * Parameters
+ *   lat             : pointer to latency budget request object
+ *   budget          : acceptable wakeup latency (in ticks)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pwr_require( lat_t *lat, cnt_t budget );
+
+/******************************************************************************
+ *
+ * Name              : pwr_release
+ *
+ * Description       : remove the latency budget request
+ *
+ * Parameters
+ *   lat             : pointer to latency budget request object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void pwr_release( lat_t *lat );
+
+/******************************************************************************
+ *
+ * Name              : pwr_budget
+ *
+ * Description       : return the current latency budget
+ *
+ * Parameters        : none
+ *
+ * Return            : the smallest of all registered latency budget requests
+ *   INFINITE        : there are no registered requests
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+cnt_t pwr_budget( void );
+
+/******************************************************************************
+ *
+ * Name              : pwr_select
+ *
+ * Description       : return the low-power idle state the idle policy selects for given idle time
+ *                     under the current latency budget
+ *
+ * Parameters
+ *   delay           : time (in ticks) to the nearest timer expiration
+ *                     INFINITE: no timer is counting
+ *
+ * Return            : pointer to low-power idle state object
+ *   0               : default idle state (wait for interrupt)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+pwr_t *pwr_select( cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : pwr_count
+ *
+ * Description       : return the number of entries to the low-power idle state
+ *
+ * Parameters
+ *   pwr             : pointer to low-power idle state object
+ *
+ * Return            : number of entries to the idle state
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned pwr_count( pwr_t *pwr ) { return pwr->count; }
+
+/******************************************************************************
+ *
+ * Name              : pwr_time
+ *
+ * Description       : return the time spent in the low-power idle state
+ *
+ * Parameters
+ *   pwr             : pointer to low-power idle state object
+ *
+ * Return            : time (in ticks) spent in the idle state
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+cnt_t pwr_time( pwr_t *pwr ) { return pwr->time; }
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : PowerState
+ *
+ * Description       : create and initialize a low-power idle state object
+ *
+ * Constructor parameters
+ *   latency         : wakeup latency of the idle state (in ticks)
+ *   residency       : minimal idle time (in ticks) for which entering the idle state pays off
+ *   enter           : entry procedure
+ *   leave           : exit procedure
+ *
+ ******************************************************************************/
+
+struct PowerState : public __pwr
+{
+	 explicit
+	 PowerState( const cnt_t _latency, const cnt_t _residency, fun_pwr_enter *_enter, fun_pwr_leave *_leave = nullptr ): __pwr _PWR_INIT(_latency, _residency, _enter, _leave) {}
+	~PowerState( void ) { pwr_unregister(this); }
+
+	void     attach( void ) {        pwr_register  (this); }
+	void     detach( void ) {        pwr_unregister(this); }
+	unsigned count ( void ) { return pwr_count     (this); }
+	cnt_t    time  ( void ) { return pwr_time      (this); }
+};
+
+/******************************************************************************
+ *
+ * Class             : LatencyRequest
+ *
+ * Description       : register the latency budget request for the lifetime of the object
+ *
+ * Constructor parameters
+ *   budget          : acceptable wakeup latency (in ticks)
+ *
+ ******************************************************************************/
+
+struct LatencyRequest : public __lat
+{
+	 explicit
+	 LatencyRequest( const cnt_t _budget ): __lat { nullptr, INFINITE } { pwr_require(this, _budget); }
+	~LatencyRequest( void ) { pwr_release(this); }
+
+	void update( cnt_t _budget ) { pwr_require(this, _budget); }
+};
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_PWR_H
@@ -0,0 +1,507 @@
+/******************************************************************************
+
+    @file    StateOS: osrwlock.h
+    @author  Rajmund Szymanski
+    @date    31.07.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_RWL_H
+#define __STATEOS_RWL_H
+
+#include "oskernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : read-write lock
+ *                     like a POSIX pthread_rwlock_t
+ *
+ ******************************************************************************/
+
+struct __rwl
+{
+	tsk_t  * queue; // next reader in the DELAYED queue
+	void   * res;   // allocated read-write lock object's resource
+	tsk_t  * write; // next writer in the DELAYED queue
+	tsk_t  * owner; // writer owning the read-write lock
+	rwl_t  * list;  // list of read-write locks held by owner
+	unsigned count; // number of readers owning the read-write lock
+	unsigned mode;  // read-write lock's preference: rwlPreferWriter or rwlPreferReader
+};
+
+/* -------------------------------------------------------------------------- */
+
+#define rwlPreferWriter ( 0U ) // new readers wait while any writer is waiting (default)
+#define rwlPreferReader ( 1U ) // new readers are admitted as long as no writer owns the lock
+
+/******************************************************************************
+ *
+ * Name              : _RWL_INIT
+ *
+ * Description       : create and initialize a read-write lock object
+ *
+ * Parameters
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers (default)
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ * Return            : read-write lock object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _RWL_INIT( _mode ) { 0, 0, 0, 0, 0, 0, _mode }
+
+/******************************************************************************
+ *
+ * Name              : OS_RWL
+ *
+ * Description       : define and initialize a read-write lock object
+ *
+ * Parameters
+ *   rwl             : name of a pointer to read-write lock object
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ ******************************************************************************/
+
+#define             OS_RWL( rwl, mode )                     \
+                       rwl_t rwl##__rwl = _RWL_INIT( mode ); \
+                       rwl_id rwl = & rwl##__rwl
+
+/******************************************************************************
+ *
+ * Name              : static_RWL
+ *
+ * Description       : define and initialize a static read-write lock object
+ *
+ * Parameters
+ *   rwl             : name of a pointer to read-write lock object
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ ******************************************************************************/
+
+#define         static_RWL( rwl, mode )                     \
+                static rwl_t rwl##__rwl = _RWL_INIT( mode ); \
+                static rwl_id rwl = & rwl##__rwl
+
+/******************************************************************************
+ *
+ * Name              : RWL_INIT
+ *
+ * Description       : create and initialize a read-write lock object
+ *
+ * Parameters
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ * Return            : read-write lock object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                RWL_INIT( mode ) \
+                      _RWL_INIT( mode )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : RWL_CREATE
+ * Alias             : RWL_NEW
+ *
+ * Description       : create and initialize a read-write lock object
+ *
+ * Parameters
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ * Return            : pointer to read-write lock object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                RWL_CREATE( mode ) \
+           (rwl_t[]) { RWL_INIT  ( mode ) }
+#define                RWL_NEW \
+                       RWL_CREATE
+#endif
+
+/******************************************************************************
+ *
+ * Name              : rwl_init
+ *
+ * Description       : initialize a read-write lock object
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void rwl_init( rwl_t *rwl, unsigned mode );
+
+/******************************************************************************
+ *
+ * Name              : rwl_create
+ * Alias             : rwl_new
+ *
+ * Description       : create and initialize a new read-write lock object
+ *
+ * Parameters
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ * Return            : pointer to read-write lock object (read-write lock successfully created)
+ *   0               : read-write lock not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+rwl_t *rwl_create( unsigned mode );
+
+__STATIC_INLINE
+rwl_t *rwl_new( unsigned mode ) { return rwl_create(mode); }
+
+/******************************************************************************
+ *
+ * Name              : rwl_kill
+ *
+ * Description       : reset the read-write lock object and wake up all waiting tasks with 'E_STOPPED' event value
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void rwl_kill( rwl_t *rwl );
+
+/******************************************************************************
+ *
+ * Name              : rwl_delete
+ *
+ * Description       : reset the read-write lock object and free allocated resource
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void rwl_delete( rwl_t *rwl );
+
+/******************************************************************************
+ *
+ * Name              : rwl_waitReadFor
+ *
+ * Description       : try to lock the read-write lock object for reading (shared access),
+ *                     wait for given duration of time if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *   delay           : duration of time (maximum number of ticks to wait for lock the read-write lock object)
+ *                     IMMEDIATE: don't wait if the read-write lock object can't be locked immediately
+ *                     INFINITE:  wait indefinitely until the read-write lock object has been locked
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for reading
+ *   E_STOPPED       : read-write lock object was killed before the specified timeout expired
+ *   E_TIMEOUT       : read-write lock object was not locked before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     the writer owning the read-write lock object inherits the priority of the waiting task
+ *
+ ******************************************************************************/
+
+unsigned rwl_waitReadFor( rwl_t *rwl, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : rwl_waitReadUntil
+ *
+ * Description       : try to lock the read-write lock object for reading (shared access),
+ *                     wait until given timepoint if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for reading
+ *   E_STOPPED       : read-write lock object was killed before the specified timeout expired
+ *   E_TIMEOUT       : read-write lock object was not locked before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     the writer owning the read-write lock object inherits the priority of the waiting task
+ *
+ ******************************************************************************/
+
+unsigned rwl_waitReadUntil( rwl_t *rwl, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : rwl_waitRead
+ *
+ * Description       : try to lock the read-write lock object for reading (shared access),
+ *                     wait indefinitely if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for reading
+ *   E_STOPPED       : read-write lock object was killed
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned rwl_waitRead( rwl_t *rwl ) { return rwl_waitReadFor(rwl, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : rwl_takeRead
+ *
+ * Description       : try to lock the read-write lock object for reading (shared access),
+ *                     don't wait if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for reading
+ *   E_TIMEOUT       : read-write lock object can't be locked immediately
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned rwl_takeRead( rwl_t *rwl ) { return rwl_waitReadFor(rwl, IMMEDIATE); }
+
+/******************************************************************************
+ *
+ * Name              : rwl_giveRead
+ *
+ * Description       : unlock the read-write lock object locked for reading,
+ *                     the last reader leaving the read-write lock object releases waiting tasks
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully unlocked
+ *   E_TIMEOUT       : read-write lock object is not locked for reading
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned rwl_giveRead( rwl_t *rwl );
+
+/******************************************************************************
+ *
+ * Name              : rwl_waitWriteFor
+ *
+ * Description       : try to lock the read-write lock object for writing (exclusive access),
+ *                     wait for given duration of time if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *   delay           : duration of time (maximum number of ticks to wait for lock the read-write lock object)
+ *                     IMMEDIATE: don't wait if the read-write lock object can't be locked immediately
+ *                     INFINITE:  wait indefinitely until the read-write lock object has been locked
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for writing
+ *   E_STOPPED       : read-write lock object was killed before the specified timeout expired
+ *   E_TIMEOUT       : read-write lock object was not locked before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     the writer owning the read-write lock object inherits the priority of the waiting task
+ *
+ ******************************************************************************/
+
+unsigned rwl_waitWriteFor( rwl_t *rwl, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : rwl_waitWriteUntil
+ *
+ * Description       : try to lock the read-write lock object for writing (exclusive access),
+ *                     wait until given timepoint if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for writing
+ *   E_STOPPED       : read-write lock object was killed before the specified timeout expired
+ *   E_TIMEOUT       : read-write lock object was not locked before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     the writer owning the read-write lock object inherits the priority of the waiting task
+ *
+ ******************************************************************************/
+
+unsigned rwl_waitWriteUntil( rwl_t *rwl, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : rwl_waitWrite
+ *
+ * Description       : try to lock the read-write lock object for writing (exclusive access),
+ *                     wait indefinitely if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for writing
+ *   E_STOPPED       : read-write lock object was killed
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned rwl_waitWrite( rwl_t *rwl ) { return rwl_waitWriteFor(rwl, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : rwl_takeWrite
+ *
+ * Description       : try to lock the read-write lock object for writing (exclusive access),
+ *                     don't wait if the read-write lock object can't be locked immediately
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully locked for writing
+ *   E_TIMEOUT       : read-write lock object can't be locked immediately
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned rwl_takeWrite( rwl_t *rwl ) { return rwl_waitWriteFor(rwl, IMMEDIATE); }
+
+/******************************************************************************
+ *
+ * Name              : rwl_giveWrite
+ *
+ * Description       : unlock the read-write lock object locked for writing (only owner task can unlock it)
+ *
+ * Parameters
+ *   rwl             : pointer to read-write lock object
+ *
+ * Return
+ *   E_SUCCESS       : read-write lock object was successfully unlocked
+ *   E_TIMEOUT       : read-write lock object can't be unlocked
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned rwl_giveWrite( rwl_t *rwl );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : RWLock
+ *
+ * Description       : create and initialize a read-write lock object
+ *
+ * Constructor parameters
+ *   mode            : read-write lock's preference
+ *                     rwlPreferWriter: waiting writers block new readers (default)
+ *                     rwlPreferReader: new readers are admitted as long as no writer owns the lock
+ *
+ ******************************************************************************/
+
+struct RWLock : public __rwl
+{
+	 explicit
+	 RWLock( const unsigned _mode = rwlPreferWriter ): __rwl _RWL_INIT(_mode) {}
+	~RWLock( void ) { assert(owner == nullptr && count == 0); }
+
+	void     kill          ( void )         {        rwl_kill          (this);         }
+	unsigned waitReadFor   ( cnt_t _delay ) { return rwl_waitReadFor   (this, _delay); }
+	unsigned waitReadUntil ( cnt_t _time  ) { return rwl_waitReadUntil (this, _time);  }
+	unsigned waitRead      ( void )         { return rwl_waitRead      (this);         }
+	unsigned takeRead      ( void )         { return rwl_takeRead      (this);         }
+	unsigned giveRead      ( void )         { return rwl_giveRead      (this);         }
+	unsigned waitWriteFor  ( cnt_t _delay ) { return rwl_waitWriteFor  (this, _delay); }
+	unsigned waitWriteUntil( cnt_t _time  ) { return rwl_waitWriteUntil(this, _time);  }
+	unsigned waitWrite     ( void )         { return rwl_waitWrite     (this);         }
+	unsigned takeWrite     ( void )         { return rwl_takeWrite     (this);         }
+	unsigned giveWrite     ( void )         { return rwl_giveWrite     (this);         }
+};
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_RWL_H
@@ -53,6 +53,7 @@ struct __sem
 	void   * res;   // allocated semaphore object's resource
 	unsigned count; // semaphore's current value
 	unsigned limit; // semaphore's value limit
+	unsigned mode;  // waiting mode: semPrio or semFifo
 };
 
 /* -------------------------------------------------------------------------- */
@@ -60,6 +61,9 @@ struct __sem
 #define semBinary    (  1U ) // binary semaphore
 #define semCounting  ( ~0U ) // counting semaphore
 
+#define semPrio      (  0U ) // waiting tasks are woken up in the priority order (default)
+#define semFifo      (  1U ) // waiting tasks are woken up in the arrival order
+
 /******************************************************************************
  *
  * Name              : _SEM_INIT
@@ -72,6 +76,9 @@ struct __sem
  *                     semBinary: binary semaphore
  *                     semCounting: counting semaphore
  *                     otherwise: limited semaphore
+ *   mode            : waiting mode
+ *                     semPrio: tasks are woken up in the priority order
+ *                     semFifo: tasks are woken up in the arrival order
  *
  * Return            : semaphore object
  *
@@ -79,7 +86,7 @@ struct __sem
  *
  ******************************************************************************/
 
-#define               _SEM_INIT( _init, _limit ) { 0, 0, _init, _limit }
+#define               _SEM_INIT( _init, _limit, _mode ) { 0, 0, _init, _limit, _mode }
 
 /******************************************************************************
  *
@@ -97,8 +104,8 @@ struct __sem
  *
  ******************************************************************************/
 
-#define             OS_SEM( sem, init, limit )                     \
-                       sem_t sem##__sem = _SEM_INIT( init, limit ); \
+#define             OS_SEM( sem, init, limit )                               \
+                       sem_t sem##__sem = _SEM_INIT( init, limit, semPrio ); \
                        sem_id sem = & sem##__sem
 
 /******************************************************************************
@@ -117,8 +124,48 @@ struct __sem
  *
  ******************************************************************************/
 
-#define         static_SEM( sem, init, limit )                     \
-                static sem_t sem##__sem = _SEM_INIT( init, limit ); \
+#define         static_SEM( sem, init, limit )                               \
+                static sem_t sem##__sem = _SEM_INIT( init, limit, semPrio ); \
+                static sem_id sem = & sem##__sem
+
+/******************************************************************************
+ *
+ * Name              : OS_SEM_FIFO
+ *
+ * Description       : define and initialize a semaphore object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   sem             : name of a pointer to semaphore object
+ *   init            : initial value of semaphore counter
+ *   limit           : maximum value of semaphore counter
+ *                     semBinary: binary semaphore
+ *                     semCounting: counting semaphore
+ *                     otherwise: limited semaphore
+ *
+ ******************************************************************************/
+
+#define             OS_SEM_FIFO( sem, init, limit )                          \
+                       sem_t sem##__sem = _SEM_INIT( init, limit, semFifo ); \
+                       sem_id sem = & sem##__sem
+
+/******************************************************************************
+ *
+ * Name              : static_SEM_FIFO
+ *
+ * Description       : define and initialize a static semaphore object with the arrival order of waiting tasks
+ *
+ * Parameters
+ *   sem             : name of a pointer to semaphore object
+ *   init            : initial value of semaphore counter
+ *   limit           : maximum value of semaphore counter
+ *                     semBinary: binary semaphore
+ *                     semCounting: counting semaphore
+ *                     otherwise: limited semaphore
+ *
+ ******************************************************************************/
+
+#define         static_SEM_FIFO( sem, init, limit )                          \
+                static sem_t sem##__sem = _SEM_INIT( init, limit, semFifo ); \
                 static sem_id sem = & sem##__sem
 
 /******************************************************************************
@@ -142,7 +189,7 @@ struct __sem
 
 #ifndef __cplusplus
 #define                SEM_INIT( init, limit ) \
-                      _SEM_INIT( init, limit )
+                      _SEM_INIT( init, limit, semPrio )
 #endif
 
 /******************************************************************************
@@ -220,6 +267,26 @@ sem_t *sem_create( unsigned init, unsigned limit );
 __STATIC_INLINE
 sem_t *sem_new( unsigned init, unsigned limit ) { return sem_create(init, limit); }
 
+/******************************************************************************
+ *
+ * Name              : sem_setMode
+ *
+ * Description       : set the waiting mode of the semaphore object
+ *
+ * Parameters
+ *   sem             : pointer to semaphore object
+ *   mode            : waiting mode
+ *                     semPrio: tasks are woken up in the priority order (default)
+ *                     semFifo: tasks are woken up in the arrival order
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode, before any task waits for the semaphore
+ *
+ ******************************************************************************/
+
+void sem_setMode( sem_t *sem, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : sem_kill
@@ -345,6 +412,29 @@ unsigned sem_take( sem_t *sem );
 __STATIC_INLINE
 unsigned sem_takeISR( sem_t *sem ) { return sem_take(sem); }
 
+/******************************************************************************
+ *
+ * Name              : sem_takeN
+ * ISR alias         : sem_takeNISR
+ *
+ * Description       : try to lock the semaphore object up to 'num' times in a single critical section,
+ *                     don't wait if the semaphore object can't be locked immediately
+ *
+ * Parameters
+ *   sem             : pointer to semaphore object
+ *   num             : requested number of semaphore units
+ *
+ * Return            : number of semaphore units successfully locked (0 .. num)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned sem_takeN( sem_t *sem, unsigned num );
+
+__STATIC_INLINE
+unsigned sem_takeNISR( sem_t *sem, unsigned num ) { return sem_takeN(sem, num); }
+
 /******************************************************************************
  *
  * Name              : sem_sendFor
@@ -436,6 +526,30 @@ unsigned sem_give( sem_t *sem );
 __STATIC_INLINE
 unsigned sem_giveISR( sem_t *sem ) { return sem_give(sem); }
 
+/******************************************************************************
+ *
+ * Name              : sem_giveN
+ * ISR alias         : sem_giveNISR
+ *
+ * Description       : try to unlock the semaphore object up to 'num' times in a single critical section
+ *                     (waiting tasks are resumed first, the semaphore's value is incremented with the rest),
+ *                     don't wait if the semaphore object can't be unlocked immediately
+ *
+ * Parameters
+ *   sem             : pointer to semaphore object
+ *   num             : requested number of semaphore units
+ *
+ * Return            : number of semaphore units successfully unlocked (0 .. num)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned sem_giveN( sem_t *sem, unsigned num );
+
+__STATIC_INLINE
+unsigned sem_giveNISR( sem_t *sem, unsigned num ) { return sem_giveN(sem, num); }
+
 #ifdef __cplusplus
 }
 #endif
@@ -456,26 +570,34 @@ unsigned sem_giveISR( sem_t *sem ) { return sem_give(sem); }
  *                     semBinary: binary semaphore
  *                     semCounting: counting semaphore (default)
  *                     otherwise: limited semaphore
+ *   mode            : waiting mode
+ *                     semPrio: tasks are woken up in the priority order (default)
+ *                     semFifo: tasks are woken up in the arrival order
  *
  ******************************************************************************/
 
 struct Semaphore : public __sem
 {
 	 explicit
-	 Semaphore( const unsigned _init, const unsigned _limit = semCounting ): __sem _SEM_INIT(_init, _limit) {}
+	 Semaphore( const unsigned _init, const unsigned _limit = semCounting, const unsigned _mode = semPrio ): __sem _SEM_INIT(_init, _limit, _mode) {}
 	~Semaphore( void ) { assert(queue == nullptr); }
 
 	void     kill     ( void )         {        sem_kill     (this);         }
+	void     setMode  ( unsigned _mode){        sem_setMode  (this, _mode);  }
 	unsigned waitFor  ( cnt_t _delay ) { return sem_waitFor  (this, _delay); }
 	unsigned waitUntil( cnt_t _time )  { return sem_waitUntil(this, _time);  }
 	unsigned wait     ( void )         { return sem_wait     (this);         }
 	unsigned take     ( void )         { return sem_take     (this);         }
 	unsigned takeISR  ( void )         { return sem_takeISR  (this);         }
+	unsigned takeN    ( unsigned _num ){ return sem_takeN    (this, _num);   }
+	unsigned takeNISR ( unsigned _num ){ return sem_takeNISR (this, _num);   }
 	unsigned sendFor  ( cnt_t _delay ) { return sem_sendFor  (this, _delay); }
 	unsigned sendUntil( cnt_t _time )  { return sem_sendUntil(this, _time);  }
 	unsigned send     ( void )         { return sem_send     (this);         }
 	unsigned give     ( void )         { return sem_give     (this);         }
 	unsigned giveISR  ( void )         { return sem_giveISR  (this);         }
+	unsigned giveN    ( unsigned _num ){ return sem_giveN    (this, _num);   }
+	unsigned giveNISR ( unsigned _num ){ return sem_giveNISR (this, _num);   }
 };
 
 /******************************************************************************
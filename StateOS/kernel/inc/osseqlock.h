@@ -0,0 +1,338 @@
+/******************************************************************************
+
+    @file    StateOS: osseqlock.h
+    @author  Rajmund Szymanski
+    @date    18.07.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_SEQ_H
+#define __STATEOS_SEQ_H
+
+#include "oskernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sequence lock
+ *                     (versioned data published by a single writer and read optimistically)
+ *
+ ******************************************************************************/
+
+typedef volatile unsigned seq_t, * const seq_id;
+
+/******************************************************************************
+ *
+ * Name              : _SEQ_INIT
+ *
+ * Description       : create and initialize a sequence lock object
+ *
+ * Parameters        : none
+ *
+ * Return            : sequence lock object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _SEQ_INIT()   0
+
+/******************************************************************************
+ *
+ * Name              : OS_SEQ
+ *
+ * Description       : define and initialize a sequence lock object
+ *
+ * Parameters
+ *   seq             : name of a pointer to sequence lock object
+ *
+ ******************************************************************************/
+
+#define             OS_SEQ( seq )                     \
+                       seq_t seq##__seq = _SEQ_INIT(); \
+                       seq_id seq = & seq##__seq
+
+/******************************************************************************
+ *
+ * Name              : static_SEQ
+ *
+ * Description       : define and initialize a static sequence lock object
+ *
+ * Parameters
+ *   seq             : name of a pointer to sequence lock object
+ *
+ ******************************************************************************/
+
+#define         static_SEQ( seq )                     \
+                static seq_t seq##__seq = _SEQ_INIT(); \
+                static seq_id seq = & seq##__seq
+
+/******************************************************************************
+ *
+ * Name              : SEQ_INIT
+ *
+ * Description       : create and initialize a sequence lock object
+ *
+ * Parameters        : none
+ *
+ * Return            : sequence lock object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                SEQ_INIT() \
+                      _SEQ_INIT()
+#endif
+
+/******************************************************************************
+ *
+ * Name              : SEQ_CREATE
+ * Alias             : SEQ_NEW
+ *
+ * Description       : create and initialize a sequence lock object
+ *
+ * Parameters        : none
+ *
+ * Return            : pointer to sequence lock object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                SEQ_CREATE() \
+           (seq_t[]) { SEQ_INIT  () }
+#define                SEQ_NEW \
+                       SEQ_CREATE
+#endif
+
+/******************************************************************************
+ *
+ * Name              : seq_init
+ *
+ * Description       : initialize a sequence lock object
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void seq_init( seq_t *seq ) { *seq = 0; }
+
+/******************************************************************************
+ *
+ * Name              : seq_writeBegin
+ *
+ * Description       : start updating the data protected by the sequence lock object
+ *                     (the sequence number becomes odd)
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *
+ * Return            : none
+ *
+ * Note              : only one writer is allowed, it is not protected against other writers
+ *                     may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void seq_writeBegin( seq_t *seq )
+{
+	*seq = *seq + 1;
+	port_mem_barrier();
+}
+
+/******************************************************************************
+ *
+ * Name              : seq_writeEnd
+ *
+ * Description       : finish updating the data protected by the sequence lock object
+ *                     (the sequence number becomes even again)
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void seq_writeEnd( seq_t *seq )
+{
+	port_mem_barrier();
+	*seq = *seq + 1;
+}
+
+/******************************************************************************
+ *
+ * Name              : seq_readBegin
+ *
+ * Description       : start reading the data protected by the sequence lock object
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *
+ * Return            : current sequence number, to be passed to seq_readRetry
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned seq_readBegin( seq_t *seq )
+{
+	unsigned num = *seq;
+	port_mem_barrier();
+	return num;
+}
+
+/******************************************************************************
+ *
+ * Name              : seq_readRetry
+ *
+ * Description       : finish reading the data protected by the sequence lock object
+ *                     and check whether the copy is consistent
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *   num             : sequence number returned by seq_readBegin
+ *
+ * Return
+ *   true            : the data was being updated during reading, the copy must be discarded and read again
+ *   false           : the copy is consistent
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     the reader must not preempt the writer in the middle of the update (e.g. the writer
+ *                     is an interrupt handler or a task with a priority not lower than the priority of readers),
+ *                     otherwise the retry loop will never end
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+bool seq_readRetry( seq_t *seq, unsigned num )
+{
+	port_mem_barrier();
+	return (num & 1U) || *seq != num;
+}
+
+/******************************************************************************
+ *
+ * Name              : seq_write
+ *
+ * Description       : copy the data from the buffer into the data object protected by the sequence lock object
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *   data            : pointer to the protected data object
+ *   src             : pointer to the source buffer
+ *   size            : size of the protected data object
+ *
+ * Return            : none
+ *
+ * Note              : only one writer is allowed
+ *                     may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+void seq_write( seq_t *seq, void *data, const void *src, size_t size );
+
+/******************************************************************************
+ *
+ * Name              : seq_read
+ *
+ * Description       : copy the data object protected by the sequence lock object into the buffer,
+ *                     repeat copying until a consistent copy has been made,
+ *                     never disable interrupts and never block
+ *
+ * Parameters
+ *   seq             : pointer to sequence lock object
+ *   data            : pointer to the protected data object
+ *   dst             : pointer to the destination buffer
+ *   size            : size of the protected data object
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     the reader must not preempt the writer in the middle of the update
+ *
+ ******************************************************************************/
+
+void seq_read( seq_t *seq, const void *data, void *dst, size_t size );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : Seqlock<>
+ *
+ * Description       : create and initialize a data object of type T protected by a sequence lock
+ *
+ * Constructor parameters
+ *   _init           : initial value of the data object
+ *
+ * Note              : T must be trivially copyable
+ *
+ ******************************************************************************/
+
+template<class T>
+struct Seqlock
+{
+	 explicit
+	 Seqlock( const T &_init = T() ): seq(_SEQ_INIT()), data(_init) {}
+
+	void store( const T &_src ) {        seq_write(&seq, &data, &_src, sizeof(T)); }
+	void load ( T &_dst )       {        seq_read (&seq, &data, &_dst, sizeof(T)); }
+	T    load ( void )          { T _dst; load(_dst); return _dst; }
+
+	private:
+	seq_t seq;
+	T     data;
+};
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_SEQ_H
@@ -56,8 +56,29 @@ struct __stm
 	unsigned head;  // first element to read from data buffer
 	unsigned tail;  // first element to write into data buffer
 	char   * data;  // data buffer
+
+	unsigned mask;  // index mask if the capacity is a power of two (free-running head and tail), otherwise zero
+	unsigned mode;  // stream buffer mode: stmNormal or stmSPSC
+
+	tsk_t  * read;  // queue of tasks waiting for any amount of data
+	unsigned trigger;// minimum amount of data to wake a task waiting for any amount of data
+};
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct __stm_span stm_span_t;
+
+struct __stm_span
+{
+	char   * data;  // contiguous region of the stream buffer data
+	unsigned size;  // size of the region
 };
 
+/* -------------------------------------------------------------------------- */
+
+#define stmNormal    ( 0U ) // stream buffer object used by any number of tasks (default)
+#define stmSPSC      ( 1U ) // only the single-producer/single-consumer functions are used, the capacity is a power of two
+
 /******************************************************************************
  *
  * Name              : _STM_INIT
@@ -67,6 +88,9 @@ struct __stm
  * Parameters
  *   limit           : size of a buffer (max number of stored bytes)
  *   data            : stream buffer data
+ *   mode            : stream buffer mode
+ *                     stmNormal: stream buffer object used by any number of tasks
+ *                     stmSPSC:   only the single-producer/single-consumer functions are used
  *
  * Return            : stream buffer object
  *
@@ -74,7 +98,7 @@ struct __stm
  *
  ******************************************************************************/
 
-#define               _STM_INIT( _limit, _data ) { 0, 0, 0, _limit, 0, 0, _data }
+#define               _STM_INIT( _limit, _data, _mode ) { 0, 0, 0, _limit, 0, 0, _data, POW2MASK( _limit ), _mode, 0, 0 }
 
 /******************************************************************************
  *
@@ -109,7 +133,7 @@ struct __stm
 
 #define             OS_STM( stm, limit )                                \
                        char stm##__buf[limit];                           \
-                       stm_t stm##__stm = _STM_INIT( limit, stm##__buf ); \
+                       stm_t stm##__stm = _STM_INIT( limit, stm##__buf, stmNormal ); \
                        stm_id stm = & stm##__stm
 
 /******************************************************************************
@@ -126,7 +150,79 @@ struct __stm
 
 #define         static_STM( stm, limit )                                \
                 static char stm##__buf[limit];                           \
-                static stm_t stm##__stm = _STM_INIT( limit, stm##__buf ); \
+                static stm_t stm##__stm = _STM_INIT( limit, stm##__buf, stmNormal ); \
+                static stm_id stm = & stm##__stm
+
+/******************************************************************************
+ *
+ * Name              : OS_STM_POW2
+ *
+ * Description       : define and initialize a stream buffer object with the capacity being a power of two
+ *
+ * Parameters
+ *   stm             : name of a pointer to stream buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_STM_POW2( stm, limit ) \
+                    OS_STM( stm, POW2( limit ) )
+
+/******************************************************************************
+ *
+ * Name              : static_STM_POW2
+ *
+ * Description       : define and initialize a static stream buffer object with the capacity being a power of two
+ *
+ * Parameters
+ *   stm             : name of a pointer to stream buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_STM_POW2( stm, limit ) \
+                static_STM( stm, POW2( limit ) )
+
+/******************************************************************************
+ *
+ * Name              : OS_STM_SPSC
+ *
+ * Description       : define and initialize a stream buffer object in the stmSPSC mode
+ *
+ * Parameters
+ *   stm             : name of a pointer to stream buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define             OS_STM_SPSC( stm, limit )                                            \
+                       char stm##__buf[POW2( limit )];                                    \
+                       stm_t stm##__stm = _STM_INIT( POW2( limit ), stm##__buf, stmSPSC ); \
+                       stm_id stm = & stm##__stm
+
+/******************************************************************************
+ *
+ * Name              : static_STM_SPSC
+ *
+ * Description       : define and initialize a static stream buffer object in the stmSPSC mode
+ *
+ * Parameters
+ *   stm             : name of a pointer to stream buffer object
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+#define         static_STM_SPSC( stm, limit )                                            \
+                static char stm##__buf[POW2( limit )];                                    \
+                static stm_t stm##__stm = _STM_INIT( POW2( limit ), stm##__buf, stmSPSC ); \
                 static stm_id stm = & stm##__stm
 
 /******************************************************************************
@@ -146,7 +242,7 @@ struct __stm
 
 #ifndef __cplusplus
 #define                STM_INIT( limit ) \
-                      _STM_INIT( limit, _STM_DATA( limit ) )
+                      _STM_INIT( limit, _STM_DATA( limit ), stmNormal )
 #endif
 
 /******************************************************************************
@@ -213,6 +309,27 @@ stm_t *stm_create( unsigned limit );
 __STATIC_INLINE
 stm_t *stm_new( unsigned limit ) { return stm_create(limit); }
 
+/******************************************************************************
+ *
+ * Name              : stm_setMode
+ *
+ * Description       : set the mode of the stream buffer object
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   mode            : stream buffer mode
+ *                     stmNormal: stream buffer object used by any number of tasks (default)
+ *                     stmSPSC:   only the single-producer/single-consumer functions are used
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode, while no task waits for the stream buffer
+ *                     the capacity of the stream buffer must be a power of two for the stmSPSC mode
+ *
+ ******************************************************************************/
+
+void stm_setMode( stm_t *stm, unsigned mode );
+
 /******************************************************************************
  *
  * Name              : stm_kill
@@ -349,6 +466,120 @@ unsigned stm_take( stm_t *stm, void *data, unsigned size );
 __STATIC_INLINE
 unsigned stm_takeISR( stm_t *stm, void *data, unsigned size ) { return stm_take(stm, data, size); }
 
+/******************************************************************************
+ *
+ * Name              : stm_readFor
+ *
+ * Description       : try to transfer any amount of data (up to the size of write buffer) from the stream buffer object,
+ *                     wait for given duration of time while the stream buffer object is empty;
+ *                     the waiting task is woken when the amount of data reaches the trigger level
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *   delay           : duration of time (maximum number of ticks to wait while the stream buffer object is empty)
+ *                     IMMEDIATE: don't wait if the stream buffer object is empty
+ *                     INFINITE:  wait indefinitely while the stream buffer object is empty
+ *
+ * Return            : number of bytes read from the stream buffer,
+ *                     when the timeout expires the data received below the trigger level is returned
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned stm_readFor( stm_t *stm, void *data, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_readUntil
+ *
+ * Description       : try to transfer any amount of data (up to the size of write buffer) from the stream buffer object,
+ *                     wait until given timepoint while the stream buffer object is empty;
+ *                     the waiting task is woken when the amount of data reaches the trigger level
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *   time            : timepoint value
+ *
+ * Return            : number of bytes read from the stream buffer,
+ *                     when the timeout expires the data received below the trigger level is returned
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned stm_readUntil( stm_t *stm, void *data, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_read
+ *
+ * Description       : try to transfer any amount of data (up to the size of write buffer) from the stream buffer object,
+ *                     wait indefinitely while the stream buffer object is empty;
+ *                     the waiting task is woken when the amount of data reaches the trigger level
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *
+ * Return            : number of bytes read from the stream buffer
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned stm_read( stm_t *stm, void *data, unsigned size ) { return stm_readFor(stm, data, size, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : stm_tryRead
+ * ISR alias         : stm_tryReadISR
+ *
+ * Description       : try to transfer any amount of data (up to the size of write buffer) from the stream buffer object,
+ *                     don't wait if the stream buffer object is empty
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *
+ * Return            : number of bytes read from the stream buffer
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned stm_tryRead( stm_t *stm, void *data, unsigned size );
+
+__STATIC_INLINE
+unsigned stm_tryReadISR( stm_t *stm, void *data, unsigned size ) { return stm_tryRead(stm, data, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_setTrigger
+ *
+ * Description       : set the trigger level of the stream buffer object,
+ *                     a task waiting in stm_read* is woken when the amount of data reaches this level
+ *                     (or earlier, when a writer would have to wait for the free space)
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   trigger         : trigger level (in bytes), zero or one: wake the waiting task when any data arrives
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+void stm_setTrigger( stm_t *stm, unsigned trigger );
+
 /******************************************************************************
  *
  * Name              : stm_sendFor
@@ -478,6 +709,420 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size );
 __STATIC_INLINE
 unsigned stm_pushISR( stm_t *stm, const void *data, unsigned size ) { return stm_push(stm, data, size); }
 
+/******************************************************************************
+ *
+ * Name              : stm_reserve
+ * ISR alias         : stm_reserveISR
+ *
+ * Description       : get the free space of the stream buffer object as up to two contiguous writable regions,
+ *                     the data written directly into the regions is published with the stm_commit function
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   span            : array of two regions (the second one is used when the free space wraps around the end of the data buffer)
+ *
+ * Return            : total size of the regions (amount of free space in the stream buffer)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only one producer may use reserve / commit functions and must not be mixed with other functions writing to the stream buffer
+ *
+ ******************************************************************************/
+
+unsigned stm_reserve( stm_t *stm, stm_span_t span[2] );
+
+__STATIC_INLINE
+unsigned stm_reserveISR( stm_t *stm, stm_span_t span[2] ) { return stm_reserve(stm, span); }
+
+/******************************************************************************
+ *
+ * Name              : stm_reserveFor
+ *
+ * Description       : get the free space of the stream buffer object as up to two contiguous writable regions,
+ *                     wait for given duration of time while the stream buffer object has less than requested amount of free space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   span            : array of two regions (the second one is used when the free space wraps around the end of the data buffer)
+ *   size            : requested amount of free space
+ *   delay           : duration of time (maximum number of ticks to wait for the free space)
+ *                     IMMEDIATE: don't wait if the stream buffer object has not enough free space
+ *                     INFINITE:  wait indefinitely for the free space
+ *
+ * Return
+ *   E_SUCCESS       : at least requested amount of free space was successfully reserved
+ *   E_STOPPED       : stream buffer object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object has not enough free space before the specified timeout expired
+ *                     or requested size is incorrect
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned stm_reserveFor( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_reserveUntil
+ *
+ * Description       : get the free space of the stream buffer object as up to two contiguous writable regions,
+ *                     wait until given timepoint while the stream buffer object has less than requested amount of free space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   span            : array of two regions (the second one is used when the free space wraps around the end of the data buffer)
+ *   size            : requested amount of free space
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : at least requested amount of free space was successfully reserved
+ *   E_STOPPED       : stream buffer object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object has not enough free space before the specified timeout expired
+ *                     or requested size is incorrect
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned stm_reserveUntil( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_commit
+ * ISR alias         : stm_commitISR
+ *
+ * Description       : publish data written directly into the regions returned by the stm_reserve[For|Until] function,
+ *                     resume tasks waiting for the data
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   size            : amount of written data
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully published
+ *   E_TIMEOUT       : size is greater than the amount of free space
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned stm_commit( stm_t *stm, unsigned size );
+
+__STATIC_INLINE
+unsigned stm_commitISR( stm_t *stm, unsigned size ) { return stm_commit(stm, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_peek
+ * ISR alias         : stm_peekISR
+ *
+ * Description       : get the data of the stream buffer object as up to two contiguous readable regions without removing it,
+ *                     the data read directly from the regions is released with the stm_consume function
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   span            : array of two regions (the second one is used when the data wraps around the end of the data buffer)
+ *
+ * Return            : total size of the regions (amount of data contained in the stream buffer)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only one consumer may use peek / consume functions and must not be mixed with other functions reading from the stream buffer
+ *
+ ******************************************************************************/
+
+unsigned stm_peek( stm_t *stm, stm_span_t span[2] );
+
+__STATIC_INLINE
+unsigned stm_peekISR( stm_t *stm, stm_span_t span[2] ) { return stm_peek(stm, span); }
+
+/******************************************************************************
+ *
+ * Name              : stm_peekFor
+ *
+ * Description       : get the data of the stream buffer object as up to two contiguous readable regions without removing it,
+ *                     wait for given duration of time while the stream buffer object is empty
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   span            : array of two regions (the second one is used when the data wraps around the end of the data buffer)
+ *   size            : requested amount of data
+ *   delay           : duration of time (maximum number of ticks to wait while the stream buffer object is empty)
+ *                     IMMEDIATE: don't wait if the stream buffer object is empty
+ *                     INFINITE:  wait indefinitely while the stream buffer object is empty
+ *
+ * Return
+ *   E_SUCCESS       : at least requested amount of data is available in the regions
+ *   E_STOPPED       : stream buffer object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object was not received enough data before the specified timeout expired
+ *                     or requested size is incorrect
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned stm_peekFor( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_peekUntil
+ *
+ * Description       : get the data of the stream buffer object as up to two contiguous readable regions without removing it,
+ *                     wait until given timepoint while the stream buffer object is empty
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   span            : array of two regions (the second one is used when the data wraps around the end of the data buffer)
+ *   size            : requested amount of data
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : at least requested amount of data is available in the regions
+ *   E_STOPPED       : stream buffer object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object was not received enough data before the specified timeout expired
+ *                     or requested size is incorrect
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned stm_peekUntil( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_consume
+ * ISR alias         : stm_consumeISR
+ *
+ * Description       : release data read directly from the regions returned by the stm_peek[For|Until] function,
+ *                     resume tasks waiting for the free space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   size            : amount of released data
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully released
+ *   E_TIMEOUT       : size is greater than the amount of data contained in the stream buffer
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+unsigned stm_consume( stm_t *stm, unsigned size );
+
+__STATIC_INLINE
+unsigned stm_consumeISR( stm_t *stm, unsigned size ) { return stm_consume(stm, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_waitSPSCFor
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     wait for given duration of time while the stream buffer object is empty
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *   delay           : duration of time (maximum number of ticks to wait while the stream buffer object is empty)
+ *                     IMMEDIATE: don't wait if the stream buffer object is empty
+ *                     INFINITE:  wait indefinitely while the stream buffer object is empty
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the stream buffer object
+ *   E_STOPPED       : stream buffer queue object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object was not received enough data before the specified timeout expired
+ *                     or write buffer has an incorrect size
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned stm_waitSPSCFor( stm_t *stm, void *data, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_waitSPSCUntil
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     wait until given timepoint while the stream buffer object is empty
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the stream buffer object
+ *   E_STOPPED       : stream buffer queue object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object was not received enough data before the specified timeout expired
+ *                     or write buffer has an incorrect size
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned stm_waitSPSCUntil( stm_t *stm, void *data, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_waitSPSC
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     wait indefinitely while the stream buffer object is empty
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the stream buffer object
+ *   E_STOPPED       : stream buffer queue object was killed
+ *   E_TIMEOUT       : write buffer has an incorrect size
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned stm_waitSPSC( stm_t *stm, void *data, unsigned size ) { return stm_waitSPSCFor(stm, data, size, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : stm_takeSPSC
+ * ISR alias         : stm_takeSPSCISR
+ *
+ * Description       : try to transfer data from the stream buffer object,
+ *                     don't wait if the stream buffer object does not have enough data
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to write buffer
+ *   size            : size of write buffer
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered from the stream buffer object
+ *   E_TIMEOUT       : stream buffer object does not have enough data
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned stm_takeSPSC( stm_t *stm, void *data, unsigned size );
+
+__STATIC_INLINE
+unsigned stm_takeSPSCISR( stm_t *stm, void *data, unsigned size ) { return stm_takeSPSC(stm, data, size); }
+
+/******************************************************************************
+ *
+ * Name              : stm_sendSPSCFor
+ *
+ * Description       : try to transfer data to the stream buffer object,
+ *                     wait for given duration of time while the stream buffer object does not have enough space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *   delay           : duration of time (maximum number of ticks to wait while the stream buffer object does not have enough space)
+ *                     IMMEDIATE: don't wait if the stream buffer object does not have enough space
+ *                     INFINITE:  wait indefinitely while the stream buffer object does not have enough space
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered to the stream buffer object
+ *   E_STOPPED       : stream buffer queue object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object was not freed enough space before the specified timeout expired
+ *                     or read buffer has an incorrect size
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned stm_sendSPSCFor( stm_t *stm, const void *data, unsigned size, cnt_t delay );
+
+/******************************************************************************
+ *
+ * Name              : stm_sendSPSCUntil
+ *
+ * Description       : try to transfer data to the stream buffer object,
+ *                     wait until given timepoint while the stream buffer object does not have enough space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered to the stream buffer object
+ *   E_STOPPED       : stream buffer queue object was killed before the specified timeout expired
+ *   E_TIMEOUT       : stream buffer object was not freed enough space before the specified timeout expired
+ *                     or read buffer has an incorrect size
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned stm_sendSPSCUntil( stm_t *stm, const void *data, unsigned size, cnt_t time );
+
+/******************************************************************************
+ *
+ * Name              : stm_sendSPSC
+ *
+ * Description       : try to transfer data to the stream buffer object,
+ *                     wait indefinitely while the stream buffer object does not have enough space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered to the stream buffer object
+ *   E_STOPPED       : stream buffer queue object was killed
+ *   E_TIMEOUT       : read buffer has an incorrect size
+ *
+ * Note              : use only in thread mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned stm_sendSPSC( stm_t *stm, const void *data, unsigned size ) { return stm_sendSPSCFor(stm, data, size, INFINITE); }
+
+/******************************************************************************
+ *
+ * Name              : stm_giveSPSC
+ * ISR alias         : stm_giveSPSCISR
+ *
+ * Description       : try to transfer data to the stream buffer object,
+ *                     don't wait if the stream buffer object does not have enough space
+ *
+ * Parameters
+ *   stm             : pointer to stream buffer object
+ *   data            : pointer to read buffer
+ *   size            : size of read buffer
+ *
+ * Return
+ *   E_SUCCESS       : data was successfully transfered to the stream buffer object
+ *   E_TIMEOUT       : stream buffer object does not have enough space
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     single-producer/single-consumer function, use only for the stream buffer object in the stmSPSC mode
+ *
+ ******************************************************************************/
+
+unsigned stm_giveSPSC( stm_t *stm, const void *data, unsigned size );
+
+__STATIC_INLINE
+unsigned stm_giveSPSCISR( stm_t *stm, const void *data, unsigned size ) { return stm_giveSPSC(stm, data, size); }
+
 /******************************************************************************
  *
  * Name              : stm_count
@@ -541,15 +1186,22 @@ unsigned stm_spaceISR( stm_t *stm ) { return stm_space(stm); }
 struct baseStreamBuffer : public __stm
 {
 	 explicit
-	 baseStreamBuffer( const unsigned _limit, char * const _data ): __stm _STM_INIT(_limit, _data) {}
-	~baseStreamBuffer( void ) { assert(queue == nullptr); }
+	 baseStreamBuffer( const unsigned _limit, char * const _data, const unsigned _mode = stmNormal ): __stm _STM_INIT(_limit, _data, _mode) {}
+	~baseStreamBuffer( void ) { assert(queue == nullptr && read == nullptr); }
 
 	void     kill     ( void )                                            {        stm_kill     (this);                       }
+	void     setMode  ( unsigned _mode )                                  {        stm_setMode  (this, _mode);                }
 	unsigned waitFor  (       void *_data, unsigned _size, cnt_t _delay ) { return stm_waitFor  (this, _data, _size, _delay); }
 	unsigned waitUntil(       void *_data, unsigned _size, cnt_t _time  ) { return stm_waitUntil(this, _data, _size, _time);  }
 	unsigned wait     (       void *_data, unsigned _size )               { return stm_wait     (this, _data, _size);         }
 	unsigned take     (       void *_data, unsigned _size )               { return stm_take     (this, _data, _size);         }
 	unsigned takeISR  (       void *_data, unsigned _size )               { return stm_takeISR  (this, _data, _size);         }
+	unsigned readFor  (       void *_data, unsigned _size, cnt_t _delay ) { return stm_readFor  (this, _data, _size, _delay); }
+	unsigned readUntil(       void *_data, unsigned _size, cnt_t _time  ) { return stm_readUntil(this, _data, _size, _time);  }
+	unsigned read     (       void *_data, unsigned _size )               { return stm_read     (this, _data, _size);         }
+	unsigned tryRead   (      void *_data, unsigned _size )               { return stm_tryRead   (this, _data, _size);        }
+	unsigned tryReadISR(      void *_data, unsigned _size )               { return stm_tryReadISR(this, _data, _size);        }
+	void     setTrigger( unsigned _trigger )                              {        stm_setTrigger(this, _trigger);            }
 	unsigned sendFor  ( const void *_data, unsigned _size, cnt_t _delay ) { return stm_sendFor  (this, _data, _size, _delay); }
 	unsigned sendUntil( const void *_data, unsigned _size, cnt_t _time  ) { return stm_sendUntil(this, _data, _size, _time);  }
 	unsigned send     ( const void *_data, unsigned _size )               { return stm_send     (this, _data, _size);         }
@@ -557,6 +1209,28 @@ struct baseStreamBuffer : public __stm
 	unsigned giveISR  ( const void *_data, unsigned _size )               { return stm_giveISR  (this, _data, _size);         }
 	unsigned push     ( const void *_data, unsigned _size )               { return stm_push     (this, _data, _size);         }
 	unsigned pushISR  ( const void *_data, unsigned _size )               { return stm_pushISR  (this, _data, _size);         }
+	unsigned reserve     ( stm_span_t *_span )                               { return stm_reserve     (this, _span);                }
+	unsigned reserveISR  ( stm_span_t *_span )                               { return stm_reserveISR  (this, _span);                }
+	unsigned reserveFor  ( stm_span_t *_span, unsigned _size, cnt_t _delay ) { return stm_reserveFor  (this, _span, _size, _delay); }
+	unsigned reserveUntil( stm_span_t *_span, unsigned _size, cnt_t _time  ) { return stm_reserveUntil(this, _span, _size, _time);  }
+	unsigned commit      ( unsigned _size )                                  { return stm_commit      (this, _size);                }
+	unsigned commitISR   ( unsigned _size )                                  { return stm_commitISR   (this, _size);                }
+	unsigned peek        ( stm_span_t *_span )                               { return stm_peek        (this, _span);                }
+	unsigned peekISR     ( stm_span_t *_span )                               { return stm_peekISR     (this, _span);                }
+	unsigned peekFor     ( stm_span_t *_span, unsigned _size, cnt_t _delay ) { return stm_peekFor     (this, _span, _size, _delay); }
+	unsigned peekUntil   ( stm_span_t *_span, unsigned _size, cnt_t _time  ) { return stm_peekUntil   (this, _span, _size, _time);  }
+	unsigned consume     ( unsigned _size )                                  { return stm_consume     (this, _size);                }
+	unsigned consumeISR  ( unsigned _size )                                  { return stm_consumeISR  (this, _size);                }
+	unsigned waitSPSCFor  (       void *_data, unsigned _size, cnt_t _delay ) { return stm_waitSPSCFor  (this, _data, _size, _delay); }
+	unsigned waitSPSCUntil(       void *_data, unsigned _size, cnt_t _time  ) { return stm_waitSPSCUntil(this, _data, _size, _time);  }
+	unsigned waitSPSC     (       void *_data, unsigned _size )               { return stm_waitSPSC     (this, _data, _size);         }
+	unsigned takeSPSC     (       void *_data, unsigned _size )               { return stm_takeSPSC     (this, _data, _size);         }
+	unsigned takeSPSCISR  (       void *_data, unsigned _size )               { return stm_takeSPSCISR  (this, _data, _size);         }
+	unsigned sendSPSCFor  ( const void *_data, unsigned _size, cnt_t _delay ) { return stm_sendSPSCFor  (this, _data, _size, _delay); }
+	unsigned sendSPSCUntil( const void *_data, unsigned _size, cnt_t _time  ) { return stm_sendSPSCUntil(this, _data, _size, _time);  }
+	unsigned sendSPSC     ( const void *_data, unsigned _size )               { return stm_sendSPSC     (this, _data, _size);         }
+	unsigned giveSPSC     ( const void *_data, unsigned _size )               { return stm_giveSPSC     (this, _data, _size);         }
+	unsigned giveSPSCISR  ( const void *_data, unsigned _size )               { return stm_giveSPSCISR  (this, _data, _size);         }
 	unsigned count    ( void )                                            { return stm_count    (this);                       }
 	unsigned countISR ( void )                                            { return stm_countISR (this);                       }
 	unsigned space    ( void )                                            { return stm_space    (this);                       }
@@ -606,6 +1280,50 @@ struct StreamBufferTT : public baseStreamBuffer
 	T data_[_limit];
 };
 
+/******************************************************************************
+ *
+ * Class             : StreamBufferPow2
+ *
+ * Description       : create and initialize a stream buffer object with the capacity being a power of two
+ *
+ * Constructor parameters
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit>
+struct StreamBufferPow2T : public StreamBufferT<_limit>
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+};
+
+/******************************************************************************
+ *
+ * Class             : StreamBufferSPSC
+ *
+ * Description       : create and initialize a stream buffer object in the stmSPSC mode
+ *
+ * Constructor parameters
+ *   limit           : size of a buffer (max number of stored bytes)
+ *
+ * Note              : compilation error if 'limit' is not a power of two
+ *
+ ******************************************************************************/
+
+template<unsigned _limit>
+struct StreamBufferSPSCT : public baseStreamBuffer
+{
+	static_assert((_limit & (_limit - 1)) == 0, "limit must be a power of two");
+
+	explicit
+	StreamBufferSPSCT( void ): baseStreamBuffer(_limit, data_, stmSPSC) {}
+
+	private:
+	char data_[_limit];
+};
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -55,25 +55,31 @@ struct __tsk
 	cnt_t    start; // inherited from timer
 	cnt_t    delay; // inherited from timer
 	cnt_t    slice;	// time slice
+	cnt_t    quantum;// time slice length (in ticks); 0: no time slicing (FIFO)
 
 	tsk_t  * back;  // previous process in the DELAYED queue
+	tsk_t  * skip;  // last (first) process with the same priority in the DELAYED queue
 	void   * sp;    // current stack pointer
 	stk_t  * top;   // top of stack
 	void   * stack; // base of stack
 
 	unsigned basic; // basic priority
 	unsigned prio;  // current priority
+	unsigned thresh;// preemption threshold: the running task can be preempted only by tasks with greater priority
 
 	tsk_t  * join;  // joinable state
 	void   * guard; // object that controls the pending process
+	bool     fifo;  // the pending process waits in the FIFO order (set before waiting, cleared on wakeup)
 
 	unsigned event; // wakeup event
 
 	struct {
-	mtx_t  * list;  // list of mutexes held
+	mtx_t  * list;  // list of mutexes held (sorted by priority required by the mutexes)
 	tsk_t  * tree;  // tree of tasks waiting for mutexes
 	}        mtx;
 
+	rwl_t  * rwl;   // list of read-write locks held for writing
+
 	union  {
 
 	struct {
@@ -123,6 +129,10 @@ struct __tsk
 	unsigned event;
 	}        evq;   // temporary data used by event queue object
 
+	struct {
+	mtx_t  * mtx;
+	}        cnd;   // temporary data used by condition variable object
+
 	}        tmp;
 #if defined(__ARMCC_VERSION) && !defined(__MICROLIB)
 	char     libspace[96];
@@ -132,6 +142,22 @@ struct __tsk
 #endif
 };
 
+/******************************************************************************
+ *
+ * Name              : _TSK_SLICE
+ *
+ * Description       : default time slice length of a task (in ticks)
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#if OS_ROBIN
+#define               _TSK_SLICE ((cnt_t)((OS_FREQUENCY)/(OS_ROBIN)))
+#else
+#define               _TSK_SLICE 0
+#endif
+
 /******************************************************************************
  *
  * Name              : _TSK_INIT
@@ -152,7 +178,7 @@ struct __tsk
  ******************************************************************************/
 
 #define               _TSK_INIT( _prio, _state, _stack, _size ) \
-                       { _OBJ_INIT(), ID_STOPPED, _state, 0, 0, 0, 0, 0, _stack+SSIZE(_size), _stack, _prio, _prio, 0, 0, 0, { 0, 0 }, { { 0, 0 } }, _TSK_EXTRA }
+                       { _OBJ_INIT(), ID_STOPPED, _state, 0, 0, 0, _TSK_SLICE, 0, 0, 0, _stack+SSIZE(_size), _stack, _prio, _prio, 0, 0, 0, false, 0, { 0, 0 }, 0, { { 0, 0 } }, _TSK_EXTRA }
 
 /******************************************************************************
  *
@@ -557,6 +583,29 @@ tsk_t *tsk_this( void ) { return System.cur; }
 
 void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned size );
 
+/******************************************************************************
+ *
+ * Name              : tsk_initThreshold
+ *
+ * Description       : initialize complete work area for task object with given preemption threshold and start the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *   stack           : base of task's private stack storage
+ *   size            : size of task private stack (in bytes)
+ *   thresh          : preemption threshold (any unsigned int value)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void tsk_initThreshold( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned size, unsigned thresh );
+
 /******************************************************************************
  *
  * Name              : wrk_create
@@ -582,6 +631,28 @@ tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size );
 __STATIC_INLINE
 tsk_t *wrk_new( unsigned prio, fun_t *state, unsigned size ) { return wrk_create(prio, state, size); }
 
+/******************************************************************************
+ *
+ * Name              : wrk_createThreshold
+ *
+ * Description       : create and initialize complete work area for task object with given preemption threshold and start the task
+ *
+ * Parameters
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *   size            : size of task private stack (in bytes)
+ *   thresh          : preemption threshold (any unsigned int value)
+ *
+ * Return            : pointer to task object (task successfully created)
+ *   0               : task not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+tsk_t *wrk_createThreshold( unsigned prio, fun_t *state, unsigned size, unsigned thresh );
+
 /******************************************************************************
  *
  * Name              : tsk_create
@@ -607,6 +678,29 @@ tsk_t *tsk_create( unsigned prio, fun_t *state ) { return wrk_create(prio, state
 __STATIC_INLINE
 tsk_t *tsk_new   ( unsigned prio, fun_t *state ) { return wrk_create(prio, state, OS_STACK_SIZE); }
 
+/******************************************************************************
+ *
+ * Name              : tsk_createThreshold
+ *
+ * Description       : create and initialize complete work area for task object with default stack size
+ *                     and given preemption threshold and start the task
+ *
+ * Parameters
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *   thresh          : preemption threshold (any unsigned int value)
+ *
+ * Return            : pointer to task object (task successfully created)
+ *   0               : task not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+tsk_t *tsk_createThreshold( unsigned prio, fun_t *state, unsigned thresh ) { return wrk_createThreshold(prio, state, OS_STACK_SIZE, thresh); }
+
 /******************************************************************************
  *
  * Name              : tsk_start
@@ -811,6 +905,88 @@ void tsk_setPrio( unsigned prio ) { tsk_prio(prio); }
 __STATIC_INLINE
 unsigned tsk_getPrio( void ) { return System.cur->basic; }
 
+/******************************************************************************
+ *
+ * Name              : tsk_setSlice
+ *
+ * Description       : set time slice length of given task
+ *                     when the slice expires, the task is rotated behind ready tasks of the same priority
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   quantum         : time slice length (in ticks)
+ *                     0: no time slicing, the task runs until it blocks or yields (FIFO)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     time slicing requires preemptive mode (OS_ROBIN > 0), default slice length is OS_FREQUENCY/OS_ROBIN
+ *                     in tick-less mode the slice is measured with resolution of OS_FREQUENCY/OS_ROBIN
+ *                     use directly after tsk_init or before tsk_start to set the slice length at initialization time
+ *
+ ******************************************************************************/
+
+void tsk_setSlice( tsk_t *tsk, cnt_t quantum );
+
+/******************************************************************************
+ *
+ * Name              : tsk_getSlice
+ *
+ * Description       : return time slice length of given task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : time slice length (in ticks)
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+cnt_t tsk_getSlice( tsk_t *tsk ) { return tsk->quantum; }
+
+/******************************************************************************
+ *
+ * Name              : tsk_setThreshold
+ *
+ * Description       : set preemption threshold of given task
+ *                     while the task is running, it can be preempted only by tasks
+ *                     with priority greater than both its current priority and the threshold
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   thresh          : preemption threshold (any unsigned int value)
+ *                     0: the task can be preempted by any task with greater priority
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     use before tsk_start to set the threshold of a defined task at initialization time,
+ *                     tsk_initThreshold, wrk_createThreshold and tsk_createThreshold set it for a task started at once
+ *
+ ******************************************************************************/
+
+void tsk_setThreshold( tsk_t *tsk, unsigned thresh );
+
+/******************************************************************************
+ *
+ * Name              : tsk_getThreshold
+ *
+ * Description       : return preemption threshold of given task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : preemption threshold of given task
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned tsk_getThreshold( tsk_t *tsk ) { return tsk->thresh; }
+
 /******************************************************************************
  *
  * Name              : tsk_waitFor
@@ -923,6 +1099,30 @@ unsigned tsk_sleepFor( cnt_t delay ) { return tmr_waitFor(&WAIT, delay); }
 __STATIC_INLINE
 unsigned tsk_delay( cnt_t delay ) { return tsk_sleepFor(delay); }
 
+/******************************************************************************
+ *
+ * Name              : tsk_sleepForSlack
+ *
+ * Description       : delay execution of current task for given duration of time
+ *                     the wakeup may be postponed by up to 'slack' ticks
+ *                     to coincide with expiration of another timer (or delayed task)
+ *
+ * Parameters
+ *   delay           : duration of time (maximum number of ticks to delay execution of current task)
+ *                     IMMEDIATE: don't delay execution of current task
+ *                     INFINITE:  delay indefinitely execution of current task
+ *   slack           : tolerance window (maximum number of ticks to postpone the wakeup)
+ *
+ * Return
+ *   E_TIMEOUT       : task object successfully finished countdown
+ *   E_STOPPED       : task object was resumed (tsk_resume)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned tsk_sleepForSlack( cnt_t delay, cnt_t slack );
+
 /******************************************************************************
  *
  * Name              : tsk_sleepNext
@@ -1081,6 +1281,10 @@ struct baseTask : public __tsk
 
 	unsigned prio     ( void )            { return __tsk::basic;                 }
 	unsigned getPrio  ( void )            { return __tsk::basic;                 }
+	void     setThreshold( unsigned _thresh ) { tsk_setThreshold(this, _thresh); }
+	unsigned getThreshold( void )         { return tsk_getThreshold(this);       }
+	void     setSlice ( cnt_t _quantum )  {        tsk_setSlice  (this, _quantum); }
+	cnt_t    getSlice ( void )            { return tsk_getSlice  (this);         }
 	bool     operator!( void )            { return __tsk::id == ID_STOPPED;      }
 #if OS_FUNCTIONAL
 	static
@@ -1100,6 +1304,10 @@ struct baseTask : public __tsk
  *   prio            : initial task priority (any unsigned int value)
  *   state           : task state (initial task function) doesn't have to be noreturn-type
  *                     it will be executed into an infinite system-implemented loop
+ *   quantum         : time slice length (in ticks); 0: no time slicing (FIFO)
+ *                     default: OS_FREQUENCY/OS_ROBIN
+ *   thresh          : preemption threshold (any unsigned int value)
+ *                     default: 0
  *
  ******************************************************************************/
 
@@ -1108,6 +1316,10 @@ struct TaskT : public baseTask
 {
 	explicit
 	TaskT( const unsigned _prio, FUN_t _state ): baseTask(_prio, _state, stack_, _size) {}
+	explicit
+	TaskT( const unsigned _prio, FUN_t _state, const cnt_t _quantum ): baseTask(_prio, _state, stack_, _size) { __tsk::quantum = _quantum; }
+	explicit
+	TaskT( const unsigned _prio, FUN_t _state, const cnt_t _quantum, const unsigned _thresh ): baseTask(_prio, _state, stack_, _size) { __tsk::quantum = _quantum; __tsk::thresh = _thresh; }
 
 	private:
 	stk_t stack_[SSIZE(_size)];
@@ -1144,6 +1356,10 @@ struct Task: public TaskT<OS_STACK_SIZE>
  *   prio            : initial task priority (any unsigned int value)
  *   state           : task state (initial task function) doesn't have to be noreturn-type
  *                     it will be executed into an infinite system-implemented loop
+ *   quantum         : time slice length (in ticks); 0: no time slicing (FIFO)
+ *                     default: OS_FREQUENCY/OS_ROBIN
+ *   thresh          : preemption threshold (any unsigned int value)
+ *                     default: 0
  *
  ******************************************************************************/
 
@@ -1152,6 +1368,8 @@ struct startTaskT : public TaskT<_size>
 {
 	explicit
 	startTaskT( const unsigned _prio, FUN_t _state ): TaskT<_size>(_prio, _state) { port_sys_init(); tsk_start(this); }
+	explicit
+	startTaskT( const unsigned _prio, FUN_t _state, const cnt_t _quantum, const unsigned _thresh ): TaskT<_size>(_prio, _state, _quantum, _thresh) { port_sys_init(); tsk_start(this); }
 };
 
 /******************************************************************************
@@ -1197,6 +1415,10 @@ namespace ThisTask
 	static inline void     setPrio   ( unsigned _prio )                {        tsk_setPrio   (_prio);                    }
 	static inline unsigned getPrio   ( void )                          { return tsk_getPrio   ();                         }
 	static inline unsigned prio      ( void )                          { return tsk_getPrio   ();                         }
+	static inline void     setThreshold( unsigned _thresh )            {        tsk_setThreshold(System.cur, _thresh);    }
+	static inline unsigned getThreshold( void )                        { return tsk_getThreshold(System.cur);             }
+	static inline void     setSlice  ( cnt_t    _quantum )             {        tsk_setSlice  (System.cur, _quantum);     }
+	static inline cnt_t    getSlice  ( void )                          { return tsk_getSlice  (System.cur);               }
 
 	static inline void     kill      ( void )                          {        tsk_kill      (System.cur);               }
 	static inline unsigned detach    ( void )                          { return tsk_detach    (System.cur);               }
@@ -1206,6 +1428,7 @@ namespace ThisTask
 	static inline unsigned waitUntil ( unsigned _flags, cnt_t _time )  { return tsk_waitUntil (_flags, _time);            }
 	static inline unsigned wait      ( unsigned _flags )               { return tsk_wait      (_flags);                   }
 	static inline unsigned sleepFor  ( cnt_t    _delay )               { return tsk_sleepFor  (_delay);                   }
+	static inline unsigned sleepForSlack( cnt_t _delay, cnt_t _slack ) { return tsk_sleepForSlack(_delay, _slack);       }
 	static inline unsigned sleepNext ( cnt_t    _delay )               { return tsk_sleepNext (_delay);                   }
 	static inline unsigned sleepUntil( cnt_t    _time )                { return tsk_sleepUntil(_time);                    }
 	static inline unsigned sleep     ( void )                          { return tsk_sleep     ();                         }
@@ -302,7 +302,14 @@ struct __tmr
  ******************************************************************************/
 
 __STATIC_INLINE
-tmr_t *tmr_thisISR( void ) { return (tmr_t *) WAIT.obj.next; }
+tmr_t *tmr_thisISR( void )
+{
+#if OS_TIMER_TASK
+	return System.tmr;
+#else
+	return (tmr_t *) WAIT.obj.next;
+#endif
+}
 
 /******************************************************************************
  *
@@ -405,6 +412,71 @@ void tmr_delete( tmr_t *tmr );
 
 void tmr_start( tmr_t *tmr, cnt_t delay, cnt_t period );
 
+/******************************************************************************
+ *
+ * Name              : tmr_startSlack
+ *
+ * Description       : start/restart periodic timer for given duration of time
+ *                     the first expiration may be postponed by up to 'slack' ticks
+ *                     to coincide with expiration of another timer (or delayed task)
+ *                     when the timer has finished the countdown, the callback procedure is launched
+ *                     do this periodically if period > 0
+ *
+ * Parameters
+ *   tmr             : pointer to timer object
+ *   delay           : duration of time (maximum number of ticks to countdown) for first expiration
+ *                     IMMEDIATE: don't countdown
+ *                     INFINITE:  countdown indefinitely
+ *   period          : duration of time (maximum number of ticks to countdown) for all next expirations
+ *                     IMMEDIATE: don't countdown
+ *                     INFINITE:  countdown indefinitely
+ *   slack           : tolerance window (maximum number of ticks to postpone the first expiration)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void tmr_startSlack( tmr_t *tmr, cnt_t delay, cnt_t period, cnt_t slack );
+
+/******************************************************************************
+ *
+ * Name              : tmr_slackCount
+ *
+ * Description       : return the number of countdowns started with a tolerance window
+ *                     (tmr_startSlack, tsk_sleepForSlack)
+ *
+ * Parameters        : none
+ *
+ * Return            : number of countdowns started with a tolerance window
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned tmr_slackCount( void ) { return System.slack; }
+
+/******************************************************************************
+ *
+ * Name              : tmr_mergeCount
+ *
+ * Description       : return the number of countdowns started with a tolerance window
+ *                     and aligned with expiration of another timer (or delayed task)
+ *                     merge rate = tmr_mergeCount() / tmr_slackCount()
+ *
+ * Parameters        : none
+ *
+ * Return            : number of aligned countdowns
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned tmr_mergeCount( void ) { return System.merge; }
+
 /******************************************************************************
  *
  * Name              : tmr_startFor
@@ -721,6 +793,7 @@ struct Timer : public __tmr
 	void kill         ( void )                                      {        tmr_kill         (this);                          }
 	void start        ( cnt_t _delay, cnt_t _period )               {        tmr_start        (this, _delay, _period);         }
 	void startFor     ( cnt_t _delay )                              {        tmr_startFor     (this, _delay);                  }
+	void startSlack   ( cnt_t _delay, cnt_t _period, cnt_t _slack ) {        tmr_startSlack   (this, _delay, _period, _slack); }
 	void startPeriodic( cnt_t _period )                             {        tmr_startPeriodic(this,         _period);         }
 #if OS_FUNCTIONAL
 	void startFrom    ( cnt_t _delay, cnt_t _period, FUN_t _state ) {        fun_ = _state;
@@ -742,7 +815,7 @@ struct Timer : public __tmr
 	bool     operator!( void )                                      { return __tmr::id == ID_STOPPED;                          }
 #if OS_FUNCTIONAL
 	static
-	void     run_( void ) { ((Timer *) WAIT.obj.next)->fun_(); }
+	void     run_( void ) { ((Timer *) tmr_thisISR())->fun_(); }
 	FUN_t    fun_;
 #endif
 };
@@ -857,7 +930,7 @@ struct startTimerUntil : public Timer
 namespace ThisTimer
 {
 #if OS_FUNCTIONAL
-	static inline void flipISR ( FUN_t _state ) { ((Timer *) WAIT.obj.next)->fun_ = _state;
+	static inline void flipISR ( FUN_t _state ) { ((Timer *) tmr_thisISR())->fun_ = _state;
 	                                              tmr_flipISR (Timer::run_);                }
 #else
 	static inline void flipISR ( FUN_t _state ) { tmr_flipISR (_state);                     }
@@ -47,6 +47,7 @@
 #include "oskernel.h"
 #include "inc/oscriticalsection.h"
 #include "inc/osspinlock.h"
+#include "inc/osseqlock.h"
 #include "inc/ossignal.h"
 #include "inc/osevent.h"
 #include "inc/osflag.h"
@@ -54,6 +55,7 @@
 #include "inc/ossemaphore.h"
 #include "inc/osmutex.h"
 #include "inc/osfastmutex.h"
+#include "inc/osrwlock.h"
 #include "inc/osconditionvariable.h"
 #include "inc/oslist.h"
 #include "inc/osmemorypool.h"
@@ -64,6 +66,7 @@
 #include "inc/oseventqueue.h"
 #include "inc/ostimer.h"
 #include "inc/ostask.h"
+#include "inc/ospower.h"
 
 #ifdef __cplusplus
 extern "C" {
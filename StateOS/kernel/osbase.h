@@ -47,6 +47,12 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#ifndef OS_TIMER_TASK
+#define OS_TIMER_TASK     0
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #if     OS_TIMER_SIZE == 16
 typedef uint16_t     cnt_t;
 #define CNT_MAX          0xFFFFU
@@ -70,6 +76,9 @@ typedef uint64_t     cnt_t;
 
 typedef struct __tmr tmr_t, * const tmr_id; // timer
 typedef struct __tsk tsk_t, * const tsk_id; // task
+typedef struct __mtx mtx_t, * const mtx_id; // mutex
+typedef struct __rwl rwl_t, * const rwl_id; // read-write lock
+typedef struct __pwr pwr_t, * const pwr_id; // low-power idle state
 typedef         void fun_t(); // timer/task procedure
 
 /* -------------------------------------------------------------------------- */
@@ -98,6 +107,14 @@ typedef struct __sys
 	volatile
 	cnt_t    cnt;   // system timer counter
 #endif
+#if OS_TIMER_TASK
+	tmr_t  * tmr;   // pointer to the timer control block of the callback procedure being executed by the timer service task
+#endif
+	unsigned sched; // nesting counter of the scheduler lock (sys_schedLock)
+	bool     defer; // context switch deferred by the scheduler lock
+	unsigned slack; // number of countdowns started with a tolerance window (tmr_startSlack, tsk_sleepForSlack)
+	unsigned merge; // number of the above countdowns aligned with expiration of another timer
+	pwr_t  * pwr;   // registered low-power idle states, sorted by latency (pwr_register)
 }	sys_t;
 
 /* -------------------------------------------------------------------------- */
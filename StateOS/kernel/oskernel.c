@@ -32,6 +32,7 @@
 #include "oskernel.h"
 #include "inc/ostimer.h"
 #include "inc/ostask.h"
+#include "inc/osrwlock.h"
 
 /* -------------------------------------------------------------------------- */
 // SYSTEM INTERNAL SERVICES
@@ -40,7 +41,33 @@
 static
 void priv_tsk_idle( void )
 {
-	__WFI();
+	cnt_t delay;
+
+	if (System.pwr == 0) // no low-power idle state is registered
+	{
+#if HW_TIMER_SIZE == 0 && OS_TICKLESS
+		__disable_irq(); // PRIMASK does not prevent WFI from waking up
+		if (IDLE.obj.next == &IDLE) // no other task is ready
+			System.cnt += port_tck_sleep(core_tmr_delay());
+		__enable_irq();
+#else
+		__WFI();
+#endif
+		return;
+	}
+
+	__disable_irq(); // PRIMASK does not prevent WFI from waking up
+	if (IDLE.obj.next == &IDLE) // no other task is ready
+	{
+		delay = core_tmr_delay();
+		if (!core_pwr_idle(delay))
+#if HW_TIMER_SIZE == 0 && OS_TICKLESS
+			System.cnt += port_tck_sleep(delay);
+#else
+			__WFI();
+#endif
+	}
+	__enable_irq();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -86,6 +113,286 @@ tmr_t WAIT = { .obj={ .prev=&WAIT.obj, .next=&WAIT.obj }, .id=ID_TIMER, .delay=I
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TIMER_WHEEL
+
+#define WHEEL_BITS  5
+#define WHEEL_SIZE (1U<<WHEEL_BITS)
+
+#if     (OS_TIMER_WHEEL-1)*WHEEL_BITS >= OS_TIMER_SIZE
+#error  osconfig.h: Incorrect OS_TIMER_WHEEL value! Too many levels for the given OS_TIMER_SIZE.
+#endif
+
+#if     (OS_TIMER_WHEEL)*WHEEL_BITS < OS_TIMER_SIZE
+#define WHEEL_FAR   1 // the wheel does not cover the whole range of system timer counter
+#endif
+
+static struct
+{
+	cnt_t    time;                            // wheel time: system time of the last update of the wheel
+	uint32_t map [OS_TIMER_WHEEL];            // bitmaps of non-empty slots
+	obj_t    slot[OS_TIMER_WHEEL][WHEEL_SIZE]; // queues of timers
+#ifdef WHEEL_FAR
+	obj_t    far;                             // queue of timers counting beyond the range of the wheel
+#endif
+	obj_t    inf;                             // queue of timers counting indefinitely
+
+}	WHEEL = {
+#ifdef WHEEL_FAR
+	.far = { .prev=&WHEEL.far, .next=&WHEEL.far },
+#endif
+	.inf = { .prev=&WHEEL.inf, .next=&WHEEL.inf },
+}; // timing wheel; WAIT holds expired timers only
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_whl_msb( cnt_t val )
+{
+#if OS_TIMER_SIZE == 64
+	if (val >> 32)
+		return port_msb((uint32_t)(val >> 32)) + 32;
+#endif
+	return port_msb((uint32_t)val);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// return slot index of the queue 'que' or -1 if 'que' is not a wheel slot
+static
+int priv_whl_index( obj_t *que )
+{
+	size_t idx = (size_t)(que - &WHEEL.slot[0][0]);
+
+	if ((uintptr_t)que < (uintptr_t)&WHEEL.slot[0][0] || idx >= (OS_TIMER_WHEEL)*WHEEL_SIZE)
+		return -1;
+
+	return (int)idx;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// put timer 'tmr' expiring 'rel' ticks after the wheel time into the appropriate queue
+static
+void priv_whl_put( tmr_t *tmr, cnt_t rel )
+{
+	obj_t *que = &WAIT.obj;
+
+	if (rel)
+	{
+		unsigned lvl = priv_whl_msb(rel) / WHEEL_BITS;
+#ifdef WHEEL_FAR
+		if (lvl >= OS_TIMER_WHEEL)
+			que = &WHEEL.far;
+		else
+#endif
+		{
+			unsigned idx = (unsigned)((cnt_t)(WHEEL.time + rel) >> (lvl * WHEEL_BITS)) % WHEEL_SIZE;
+			que = &WHEEL.slot[lvl][idx];
+
+			if ((WHEEL.map[lvl] & (1UL << idx)) == 0)
+			{
+				WHEEL.map[lvl] |= 1UL << idx;
+				que->prev = que->next = que;
+			}
+		}
+	}
+
+	priv_rdy_insert(&tmr->obj, que);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// redistribute all timers from the queue 'que' due to the current wheel time
+static
+void priv_whl_cascade( obj_t *que )
+{
+	obj_t  lst;
+	tmr_t *tmr;
+
+	if (que->next == que)
+		return;
+
+	lst.next = que->next; ((obj_t *)lst.next)->prev = &lst;
+	lst.prev = que->prev; ((obj_t *)lst.prev)->next = &lst;
+	que->prev = que->next = que;
+
+	while ((tmr = lst.next) != (tmr_t *)&lst)
+	{
+		priv_rdy_remove(&tmr->obj);
+		priv_whl_put(tmr, (cnt_t)(tmr->start + tmr->delay - WHEEL.time));
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+// get time of the nearest wheel event (slot cascade or expiration) relative to the wheel time
+// return false if the wheel is empty
+static
+bool priv_whl_next( cnt_t *next )
+{
+	unsigned lvl;
+	bool     found = false;
+
+	*next = 0;
+
+	for (lvl = 0; lvl < (OS_TIMER_WHEEL); lvl++)
+	{
+		uint32_t map = WHEEL.map[lvl];
+
+		if (map)
+		{
+			unsigned sft = lvl * WHEEL_BITS;
+			unsigned rot = (unsigned)((WHEEL.time >> sft) + 1) % WHEEL_SIZE;
+			cnt_t    off;
+
+			map = (map >> rot) | (map << ((WHEEL_SIZE - rot) % WHEEL_SIZE));
+			off = (cnt_t)(((WHEEL.time >> sft) << sft) + ((cnt_t)(port_lsb(map) + 1) << sft) - WHEEL.time);
+
+			if (!found || *next > off)
+				*next = off;
+			found = true;
+		}
+	}
+#ifdef WHEEL_FAR
+	if (WHEEL.far.next != &WHEEL.far)
+	{
+		unsigned sft = (OS_TIMER_WHEEL) * WHEEL_BITS;
+		cnt_t    off = (cnt_t)((((WHEEL.time >> sft) + 1) << sft) - WHEEL.time);
+
+		if (!found || *next > off)
+			*next = off;
+		found = true;
+	}
+#endif
+	return found;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// process all wheel events up to the time 'now'; expired timers are moved to WAIT
+static
+void priv_whl_update( cnt_t now )
+{
+	cnt_t    off;
+	unsigned lvl;
+
+	while (priv_whl_next(&off) && off <= (cnt_t)(now - WHEEL.time))
+	{
+		WHEEL.time += off;
+
+		for (lvl = 0; lvl < (OS_TIMER_WHEEL); lvl++)
+		{
+			unsigned sft = lvl * WHEEL_BITS;
+			unsigned idx = (unsigned)(WHEEL.time >> sft) % WHEEL_SIZE;
+
+			if (WHEEL.time & (((cnt_t)1 << sft) - 1))
+				break;
+
+			if (WHEEL.map[lvl] & (1UL << idx))
+			{
+				WHEEL.map[lvl] &= ~(1UL << idx);
+				priv_whl_cascade(&WHEEL.slot[lvl][idx]);
+			}
+		}
+#ifdef WHEEL_FAR
+		if ((WHEEL.time & (((cnt_t)1 << ((OS_TIMER_WHEEL) * WHEEL_BITS)) - 1)) == 0)
+			priv_whl_cascade(&WHEEL.far);
+#endif
+	}
+
+	WHEEL.time = now;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_insert( tmr_t *tmr, tid_t id )
+{
+	cnt_t now = core_sys_time();
+	cnt_t cnt = now - tmr->start;
+	cnt_t rel;
+
+	tmr->id = id;
+
+	if (tmr->delay == INFINITE)
+		priv_rdy_insert(&tmr->obj, &WHEEL.inf);
+	else
+	if (tmr->delay <= cnt)
+		priv_rdy_insert(&tmr->obj, &WAIT.obj);
+	else
+	{
+		cnt = tmr->delay - cnt;
+		rel = cnt + (cnt_t)(now - WHEEL.time);
+		priv_whl_put(tmr, rel < cnt ? CNT_MAX : rel);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_remove( tmr_t *tmr )
+{
+	obj_t *nxt = tmr->obj.next;
+	int    idx;
+
+	priv_rdy_remove(&tmr->obj);
+
+	if (nxt->next == nxt && (idx = priv_whl_index(nxt)) >= 0)
+		WHEEL.map[idx / WHEEL_SIZE] &= ~(1UL << (idx % WHEEL_SIZE));
+}
+
+/* -------------------------------------------------------------------------- */
+
+// return the first timer from the timers' queues following the queue 'que'
+// the order of queues: WAIT (expired timers), wheel slots, far timers, infinite timers
+static
+tmr_t *priv_whl_first( obj_t *que )
+{
+	int idx;
+
+	if (que == &WHEEL.inf)
+		return &WAIT;
+#ifdef WHEEL_FAR
+	if (que != &WHEEL.far)
+#endif
+	{
+		idx = (que == &WAIT.obj) ? 0 : priv_whl_index(que) + 1;
+
+		for (; idx < (OS_TIMER_WHEEL)*(int)WHEEL_SIZE; idx++)
+			if (WHEEL.map[idx / WHEEL_SIZE] & (1UL << (idx % WHEEL_SIZE)))
+				return WHEEL.slot[idx / WHEEL_SIZE][idx % WHEEL_SIZE].next;
+#ifdef WHEEL_FAR
+		if (WHEEL.far.next != &WHEEL.far)
+			return WHEEL.far.next;
+#endif
+	}
+
+	if (WHEEL.inf.next != &WHEEL.inf)
+		return WHEEL.inf.next;
+
+	return &WAIT;
+}
+
+/* -------------------------------------------------------------------------- */
+
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	obj_t *nxt = tmr->obj.next;
+
+	if (nxt == &WAIT.obj || nxt == &WHEEL.inf ||
+#ifdef WHEEL_FAR
+	    nxt == &WHEEL.far ||
+#endif
+	    priv_whl_index(nxt) >= 0)
+		return priv_whl_first(nxt);
+
+	return (tmr_t *)nxt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_TIMER_WHEEL
+
 static
 void priv_tmr_insert( tmr_t *tmr, tid_t id )
 {
@@ -107,6 +414,8 @@ void priv_tmr_remove( tmr_t *tmr )
 	priv_rdy_remove(&tmr->obj);
 }
 
+#endif//OS_TIMER_WHEEL
+
 /* -------------------------------------------------------------------------- */
 
 void core_tmr_insert( tmr_t *tmr, tid_t id )
@@ -125,7 +434,188 @@ void core_tmr_remove( tmr_t *tmr )
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_TIMER_WHEEL
+
+// find in the queue 'que' the nearest expiration (other than timer 'tmr') not earlier than 'time'
+// and not later than 'time' + 'gap'; update 'gap' and return true if found
+static
+bool priv_tmr_gap( obj_t *que, tmr_t *tmr, cnt_t time, cnt_t *gap )
+{
+	tmr_t *nxt;
+	cnt_t  off;
+	bool   found = false;
+
+	for (nxt = que->next; nxt != (tmr_t *)que; nxt = nxt->obj.next)
+	{
+		if (nxt == tmr)
+			continue;
+		off = nxt->start + nxt->delay - time;
+		if (off <= *gap)
+		{
+			*gap = off;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// search the slots covering the time range from 'time' to 'time' + 'gap' at the levels of the wheel
+static
+bool priv_tmr_align( tmr_t *tmr, cnt_t time, cnt_t *gap )
+{
+	cnt_t    rel = time - WHEEL.time;
+	cnt_t    len = *gap;
+	unsigned lvl;
+	bool     found = false;
+
+	if (rel > ((CNT_MAX)>>1))
+		return false;
+
+	for (lvl = rel ? priv_whl_msb(rel) / WHEEL_BITS : 0; lvl < (OS_TIMER_WHEEL); lvl++)
+	{
+		unsigned sft = lvl * WHEEL_BITS;
+		unsigned rot = (unsigned)(time >> sft) % WHEEL_SIZE;
+		cnt_t    cnt = ((time & (((cnt_t)1 << sft) - 1)) + len) >> sft; // number of slot boundaries in the range
+		uint32_t map = WHEEL.map[lvl];
+
+		// rotate the bitmap of non-empty slots so the slot of 'time' becomes the least significant bit
+		map = (map >> rot) | (map << ((WHEEL_SIZE - rot) % WHEEL_SIZE));
+		if (cnt < WHEEL_SIZE - 1)
+			map &= (2UL << (unsigned)cnt) - 1;
+
+		while (map)
+		{
+			unsigned idx = (rot + port_lsb(map)) % WHEEL_SIZE;
+			map &= map - 1;
+			found |= priv_tmr_gap(&WHEEL.slot[lvl][idx], tmr, time, gap);
+		}
+	}
+#ifdef WHEEL_FAR
+	{
+		unsigned sft = (OS_TIMER_WHEEL) * WHEEL_BITS;
+
+		// the timers beyond the range of the wheel do not expire before the end of its current revolution
+		if ((((WHEEL.time & (((cnt_t)1 << sft) - 1)) + rel + len) >> sft) != 0)
+			found |= priv_tmr_gap(&WHEEL.far, tmr, time, gap);
+	}
+#endif
+
+	return found;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_TIMER_WHEEL
+
+static
+bool priv_tmr_align( tmr_t *tmr, cnt_t time, cnt_t *gap )
+{
+	tmr_t *nxt = &WAIT;
+
+	do nxt = nxt->obj.next;
+	while (nxt == tmr || nxt->delay < (cnt_t)(time - nxt->start));
+
+	if (nxt->delay == INFINITE || (cnt_t)(nxt->start + nxt->delay - time) > *gap)
+		return false;
+
+	*gap = nxt->start + nxt->delay - time;
+	return true;
+}
+
+#endif//OS_TIMER_WHEEL
+
+/* -------------------------------------------------------------------------- */
+
+void core_tmr_align( tmr_t *tmr, cnt_t slack )
+{
+	cnt_t gap;
+
+	if (tmr->delay == 0 || tmr->delay == INFINITE || slack == 0)
+		return;
+
+	if (slack > INFINITE - 1 - tmr->delay)
+		slack = INFINITE - 1 - tmr->delay;
+	if (slack > ((CNT_MAX)>>1))
+		slack = ((CNT_MAX)>>1);
+
+	System.slack++;
+
+	gap = slack;
+	if (priv_tmr_align(tmr, tmr->start + tmr->delay, &gap))
+	{
+		tmr->delay += gap;
+		System.merge++;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+cnt_t core_tmr_delay( void )
+{
+	cnt_t  cnt;
+	cnt_t  end;
+#if OS_TIMER_WHEEL
+	if (WAIT.obj.next != &WAIT)
+		return 0;
+	if (!priv_whl_next(&end)) // the nearest wheel event (possibly a slot cascade)
+		return INFINITE;
+	cnt = core_sys_time() - WHEEL.time;
+#else
+	tmr_t *tmr = WAIT.obj.next;
+
+	if (tmr->delay == INFINITE)
+		return INFINITE;
+	end = tmr->delay;
+	cnt = core_sys_time() - tmr->start;
+#endif
+	return end > cnt ? end - cnt : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_WHEEL
+
+// update the wheel, move all expired timers to WAIT and return true if there are any
+// in tick-less mode set time breakpoint for the nearest wheel event
+static
+bool priv_tmr_expired( void )
+{
+#if HW_TIMER_SIZE
+	cnt_t off;
+#endif
+	for (;;)
+	{
+		if (WAIT.obj.next != &WAIT.obj)
+		return true;  // return if there are expired timers
+
+		priv_whl_update(core_sys_time());
+
+		if (WAIT.obj.next != &WAIT.obj)
+		return true;  // return if timers finished counting
 #if HW_TIMER_SIZE
+		port_tmr_stop();
+
+		if (!priv_whl_next(&off))
+		return false; // return if there are no counting timers
+
+		port_tmr_start((cnt_t)(WHEEL.time + off));
+
+		if (off > (cnt_t)(core_sys_time() - WHEEL.time))
+		return false; // return if timers still count
+
+		port_tmr_stop();
+#else
+		return false; // timers still count
+#endif
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#elif HW_TIMER_SIZE
 
 static
 bool priv_tmr_expired( tmr_t *tmr )
@@ -180,26 +670,118 @@ void priv_tmr_wakeup( tmr_t *tmr, unsigned event )
 
 /* -------------------------------------------------------------------------- */
 
-void core_tmr_handler( void )
+#if OS_TIMER_TASK
+
+static  void      priv_tmr_daemon( void );
+
+static  stk_t     TIMER_STK[SSIZE(OS_TIMER_STACK)];
+static  tsk_t     TIMER = _TSK_INIT(OS_TIMER_PRIO, priv_tmr_daemon, TIMER_STK, OS_TIMER_STACK); // timer service task
+static  tmr_t     PEND  = { .obj={ .prev=&PEND.obj, .next=&PEND.obj }, .id=ID_TIMER }; // queue of timers with pending callback procedures
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_daemon( void )
 {
 	tmr_t *tmr;
 
+	port_set_lock();
+
+	while ((tmr = PEND.obj.next) != &PEND)
+	{
+		if (tmr->state)
+		{
+			System.tmr = tmr;
+			port_clr_lock();
+			tmr->state();
+			port_set_lock();
+			System.tmr = 0;
+		}
+
+		if (tmr == PEND.obj.next) // timer was neither restarted nor stopped during the callback procedure
+		{
+			core_tmr_remove(tmr);
+			if (tmr->delay)       // expired periods are caught up
+				core_tmr_insert(tmr, ID_TIMER);
+		}
+
+		core_all_wakeup(tmr, E_SUCCESS);
+	}
+
+	core_tsk_waitFor(&PEND, INFINITE);
+
+	port_clr_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_defer( tmr_t *tmr )
+{
+	priv_tmr_remove(tmr);
+	priv_rdy_insert(&tmr->obj, &PEND.obj);
+
+	if (TIMER.id == ID_STOPPED)
+	{
+		core_ctx_init(&TIMER);
+		core_tsk_insert(&TIMER);
+	}
+	else
+	{
+		core_one_wakeup(&PEND, E_SUCCESS);
+	}
+}
+
+#endif//OS_TIMER_TASK
+
+/* -------------------------------------------------------------------------- */
+
+void core_tmr_handler( void )
+{
+	tmr_t *tmr;
+#if OS_TIMER_BATCH
+	unsigned cnt = 0;
+#endif
 	core_stk_assert();
 
 	port_set_lock();
 	{
+#if OS_TIMER_WHEEL
+		while (priv_tmr_expired())
+		{
+			tmr = WAIT.obj.next;
+#else
 		while (priv_tmr_expired(tmr = WAIT.obj.next))
 		{
+#endif
 			tmr->start += tmr->delay;
 
 			if (tmr->id == ID_TIMER)
 			{
 				tmr->delay = tmr->period;
-
+#if OS_TIMER_TASK
+				if (tmr->state)
+					priv_tmr_defer((tmr_t *)tmr);
+				else
+#endif
 				priv_tmr_wakeup((tmr_t *)tmr, E_SUCCESS);
 			}
 			else  /* id == ID_DELAYED */
 				core_tsk_wakeup((tsk_t *)tmr, E_TIMEOUT);
+
+#if OS_TIMER_BATCH
+			if (++cnt >= (OS_TIMER_BATCH))
+			{
+	#if HW_TIMER_SIZE
+				port_tmr_force(); // remaining timers will be handled in the next handler call
+				break;
+	#else
+				cnt = 0;          // open the interrupt window before the next batch
+				port_clr_lock(); port_set_barrier();
+				port_set_lock();
+	#endif
+			}
+#endif
 		}
 	}
 	port_clr_lock();
@@ -222,17 +804,153 @@ static  union  { stk_t STK[SSIZE(OS_IDLE_STACK)];
 #define IDLE_TOP (stk_t*)(&IDLE_STACK)+SSIZE(OS_IDLE_STACK)
 #define IDLE_SP  (void *)(&IDLE_STACK.CTX.ctx)
 
-tsk_t MAIN = { .obj={ .prev=&IDLE.obj, .next=&IDLE.obj }, .id=ID_READY, .top=MAIN_TOP, .basic=OS_MAIN_PRIO, .prio=OS_MAIN_PRIO }; // main task
+tsk_t MAIN = { .obj={ .prev=&IDLE.obj, .next=&IDLE.obj }, .id=ID_READY, .top=MAIN_TOP, .quantum=_TSK_SLICE, .basic=OS_MAIN_PRIO, .prio=OS_MAIN_PRIO }; // main task
 tsk_t IDLE = { .obj={ .prev=&MAIN.obj, .next=&MAIN.obj }, .id=ID_IDLE, .state=priv_tsk_idle, .sp=IDLE_SP, .top=IDLE_TOP, .stack=IDLE_STK }; // idle task and tasks queue
 sys_t System = { .cur=&MAIN };
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_PRIO_LEVELS
+
+#define PRIO_WORDS (((OS_PRIO_LEVELS)+31)/32)
+
+#if     PRIO_WORDS > 32
+#error  osconfig.h: Incorrect OS_PRIO_LEVELS value! Must be less or equal to 1024.
+#endif
+
+static struct
+{
+#if PRIO_WORDS > 1
+	uint32_t group;                // bitmap of non-empty words of the priority bitmap
+#endif
+	uint32_t map[PRIO_WORDS];      // bitmap of non-empty priority levels
+	tsk_t  * tail[OS_PRIO_LEVELS]; // last task of each priority level in tasks READY queue
+
+}	READY = {
+#if PRIO_WORDS > 1
+	.group = 1UL<<((OS_MAIN_PRIO)/32),
+#endif
+	.map   = { [(OS_MAIN_PRIO)/32] = 1UL<<((OS_MAIN_PRIO)%32) },
+	.tail  = { [OS_MAIN_PRIO] = &MAIN },
+}; // priority bitmap of tasks READY queue
+
+/* -------------------------------------------------------------------------- */
+
+// return the last task of the nearest non-empty priority level above 'prio' (or IDLE)
+static
+tsk_t *priv_rdy_above( unsigned prio )
+{
+	unsigned idx = prio / 32;
+	uint32_t map = READY.map[idx] & ~((2UL << (prio % 32)) - 1);
+
+	if (map == 0)
+	{
+#if PRIO_WORDS > 1
+		uint32_t grp = READY.group & ~((2UL << idx) - 1);
+
+		if (grp == 0)
+			return &IDLE;
+
+		idx = port_lsb(grp);
+		map = READY.map[idx];
+#else
+		return &IDLE;
+#endif
+	}
+
+	return READY.tail[idx * 32 + port_lsb(map)];
+}
+
+/* -------------------------------------------------------------------------- */
+
+// insert task 'tsk' after task 'prv' as the last task of its priority level
+static
+void priv_rdy_append( tsk_t *tsk, tsk_t *prv )
+{
+	unsigned prio = tsk->prio;
+
+	priv_rdy_insert(&tsk->obj, prv->obj.next);
+
+	READY.tail[prio] = tsk;
+	READY.map[prio / 32] |= 1UL << (prio % 32);
+#if PRIO_WORDS > 1
+	READY.group |= 1UL << (prio / 32);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_insert( tsk_t *tsk )
+{
+	tsk_t *prv;
+#if OS_ROBIN
+	tsk->slice = 0;
+#endif
+	assert(tsk != &IDLE);
+	assert(tsk->prio < (OS_PRIO_LEVELS));
+
+	prv = READY.tail[tsk->prio];
+	if (prv == 0)
+		prv = priv_rdy_above(tsk->prio);
+
+	priv_rdy_append(tsk, prv);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// insert task 'tsk' into tasks READY queue as the first task of its priority level
+static
+void priv_tsk_push( tsk_t *tsk )
+{
+	tsk_t *prv;
+
+	assert(tsk->prio < (OS_PRIO_LEVELS));
+
+	prv = READY.tail[tsk->prio];
+	if (prv == 0)
+		priv_rdy_append(tsk, priv_rdy_above(tsk->prio));
+	else
+		priv_rdy_insert(&tsk->obj, priv_rdy_above(tsk->prio)->obj.next);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_remove( tsk_t *tsk )
+{
+	unsigned prio = tsk->prio;
+	tsk_t  * prv  = tsk->obj.prev;
+
+	assert(tsk != &IDLE);
+
+	if (READY.tail[prio] == tsk)
+	{
+		if (prv != &IDLE && prv->prio == prio)
+			READY.tail[prio] = prv;
+		else
+		{
+			READY.tail[prio] = 0;
+			READY.map[prio / 32] &= ~(1UL << (prio % 32));
+#if PRIO_WORDS > 1
+			if (READY.map[prio / 32] == 0)
+			READY.group &= ~(1UL << (prio / 32));
+#endif
+		}
+	}
+
+	priv_rdy_remove(&tsk->obj);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else
+
 static
 void priv_tsk_insert( tsk_t *tsk )
 {
 	tsk_t *nxt = &IDLE;
-#if OS_ROBIN && HW_TIMER_SIZE == 0
+#if OS_ROBIN
 	tsk->slice = 0;
 #endif
 	if (tsk->prio)
@@ -250,13 +968,26 @@ void priv_tsk_remove( tsk_t *tsk )
 	priv_rdy_remove(&tsk->obj);
 }
 
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+// check if task 'tsk' (the first task in READY queue) can preempt the current task
+static
+bool priv_tsk_preempt( tsk_t *tsk )
+{
+	tsk_t *cur = System.cur;
+
+	return cur->id != ID_READY || (tsk->prio > cur->prio && tsk->prio > cur->thresh);
+}
+
 /* -------------------------------------------------------------------------- */
 
 void core_tsk_insert( tsk_t *tsk )
 {
 	tsk->id = ID_READY;
 	priv_tsk_insert(tsk);
-	if (tsk == IDLE.obj.next)
+	if (tsk == IDLE.obj.next && priv_tsk_preempt(tsk))
 		port_ctx_switch();
 }
 
@@ -264,6 +995,8 @@ void core_tsk_insert( tsk_t *tsk )
 
 void core_tsk_remove( tsk_t *tsk )
 {
+	assert(tsk != System.cur || System.sched == 0); // the current task must not stop with the scheduler locked
+
 	tsk->id = ID_STOPPED;
 	priv_tsk_remove(tsk);
 	if (tsk == System.cur)
@@ -288,9 +1021,25 @@ void core_ctx_switch( void )
 	tsk_t *cur = IDLE.obj.next;
 	tsk_t *nxt = cur->obj.next;
 	if (nxt->prio == cur->prio)
-		port_ctx_switch();
+		if (cur == System.cur || priv_tsk_preempt(cur))
+			port_ctx_switch();
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_ROBIN
+
+void core_ctx_slice( cnt_t ticks )
+{
+	tsk_t *cur = System.cur;
+
+	if (cur->quantum)
+		if ((cur->slice += ticks) >= cur->quantum)
+			core_ctx_switch();
 }
 
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 void core_tsk_loop( void )
@@ -308,18 +1057,33 @@ void core_tsk_loop( void )
 
 void core_tsk_append( tsk_t *tsk, void *obj )
 {
-	tsk_t *prv;
-	tsk_t *nxt = obj;
+	tsk_t *prv = obj;
+	tsk_t *nxt = prv->obj.queue;
 	tsk->guard = obj;
 
-	do prv = nxt, nxt = nxt->obj.queue;
-	while (nxt && tsk->prio <= nxt->prio);
+	// the delayed queue is divided into groups of tasks with the same priority;
+	// the first task of each group points (skip) to the last one and vice versa,
+	// so the whole group is passed in a single step
+	// the delayed queue of an object working in the FIFO order is a single group
+	while (nxt && (tsk->fifo || tsk->prio <= nxt->prio))
+		prv = nxt->skip, nxt = prv->obj.queue;
+
+	if (prv != obj && (tsk->fifo || prv->prio == tsk->prio))
+	{
+		tsk->skip = prv->skip;
+		tsk->skip->skip = tsk;
+	}
+	else
+		tsk->skip = tsk;
 
 	if (nxt)
 	nxt->back = tsk;
 	tsk->back = prv;
 	tsk->obj.queue = nxt;
 	prv->obj.queue = tsk;
+
+	if (tsk->mtx.tree && prv == obj) // new first task waiting for the mutex
+		core_mtx_sort(obj);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -328,13 +1092,32 @@ void core_tsk_unlink( tsk_t *tsk, unsigned event )
 {
 	tsk_t *prv = tsk->back;
 	tsk_t *nxt = tsk->obj.queue;
+	bool   fst = prv == tsk->guard || (!tsk->fifo && prv->prio != tsk->prio);
+	bool   lst = nxt == 0          || (!tsk->fifo && nxt->prio != tsk->prio);
 	tsk->event = event;
 
+	if (fst && !lst) // next task becomes the first task of the group
+	{
+		nxt->skip = tsk->skip;
+		nxt->skip->skip = nxt;
+	}
+	else
+	if (lst && !fst) // previous task becomes the last task of the group
+	{
+		prv->skip = tsk->skip;
+		prv->skip->skip = prv;
+	}
+
 	if (nxt)
 	nxt->back = prv;
 	prv->obj.queue = nxt;
+
+	if (tsk->mtx.tree && prv == tsk->guard) // the first task waiting for the mutex has gone
+		core_mtx_sort(tsk->guard);
+
 	tsk->obj.queue = 0; // necessary because of tsk_wait[Until|For] functions
 	tsk->guard = 0;
+	tsk->fifo = false;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -351,6 +1134,7 @@ static
 void priv_tsk_wait( tsk_t *tsk, void *obj )
 {
 	assert(!port_isr_inside());
+	assert(tsk != System.cur || System.sched == 0); // the current task must not block with the scheduler locked
 
 	core_tsk_append((tsk_t *)tsk, obj);
 	priv_tsk_remove((tsk_t *)tsk);
@@ -367,7 +1151,10 @@ unsigned core_tsk_waitFor( void *obj, cnt_t delay )
 	cur->delay = delay;
 
 	if (cur->delay == IMMEDIATE)
+	{
+		cur->fifo = false;
 		return E_TIMEOUT;
+	}
 
 	priv_tsk_wait(cur, obj);
 	priv_ctx_switchNow();
@@ -384,7 +1171,10 @@ unsigned core_tsk_waitNext( void *obj, cnt_t delay )
 	cur->delay = delay;
 
 	if (cur->delay == IMMEDIATE)
+	{
+		cur->fifo = false;
 		return E_TIMEOUT;
+	}
 
 	priv_tsk_wait(cur, obj);
 	priv_ctx_switchNow();
@@ -402,7 +1192,10 @@ unsigned core_tsk_waitUntil( void *obj, cnt_t time )
 	cur->delay = time - cur->start;
 
 	if (cur->delay > ((CNT_MAX)>>1))
+	{
+		cur->fifo = false;
 		return E_TIMEOUT;
+	}
 
 	priv_tsk_wait(cur, obj);
 	priv_ctx_switchNow();
@@ -455,66 +1248,188 @@ void core_all_wakeup( void *obj, unsigned event )
 
 /* -------------------------------------------------------------------------- */
 
-void core_tsk_prio( tsk_t *tsk, unsigned prio )
+static
+void priv_cur_prio( tsk_t *cur, unsigned prio )
+{
+#if OS_PRIO_LEVELS
+	tsk_t *nxt;
+
+	if (cur->id != ID_READY) // the current task may be already waiting for the context switch
+	{
+		cur->prio = prio;
+		return;
+	}
+
+	priv_tsk_remove(cur);
+	cur->prio = prio;
+	nxt = IDLE.obj.next;
+
+	if (nxt->prio > prio && nxt->prio > cur->thresh)
+	{
+		priv_tsk_insert(cur);
+		port_ctx_switch();
+	}
+	else
+		priv_tsk_push(cur);
+#else
+	tsk_t *nxt = IDLE.obj.next; // the current task protected by its preemption threshold may not be the first ready task
+
+	if (nxt == cur)
+		nxt = cur->obj.next;
+
+	cur->prio = prio;
+
+	if (nxt->prio > prio && nxt->prio > cur->thresh)
+		port_ctx_switch();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_mtx_prio( mtx_t *mtx )
+{
+	if (mtx->mode & mtxPrioProtect)
+		return mtx->prio;
+
+	if (mtx->queue)
+		return mtx->queue->prio;
+
+	return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_mtx_sort( mtx_t *mtx )
+{
+	tsk_t  *tsk = mtx->owner;
+	mtx_t **lst;
+	unsigned prio;
+
+	if (tsk == 0)
+		return;
+
+	for (lst = &tsk->mtx.list; *lst; lst = &(*lst)->list)
+	{
+		if (*lst == mtx)
+		{
+			*lst = mtx->list;
+			break;
+		}
+	}
+
+	prio = priv_mtx_prio(mtx);
+
+	for (lst = &tsk->mtx.list; *lst; lst = &(*lst)->list)
+		if (priv_mtx_prio(*lst) < prio)
+			break;
+
+	mtx->list = *lst;
+	*lst = mtx;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_rwl_prio( rwl_t *rwl )
 {
-	mtx_t *mtx;
+	unsigned prio = 0;
+
+	if (rwl->queue && prio < rwl->queue->prio)
+		prio = rwl->queue->prio;
+
+	if (rwl->write && prio < rwl->write->prio)
+		prio = rwl->write->prio;
+
+	return prio;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_tsk_prio( tsk_t *tsk, unsigned prio )
+{
+	mtx_t *mtx = tsk->mtx.list; // the list of mutexes is sorted by priority
+	rwl_t *rwl;
 
 	if (prio < tsk->basic)
 		prio = tsk->basic;
 
-	for (mtx = tsk->mtx.list; mtx; mtx = mtx->list)
-		if (mtx->queue)
-			if (prio < mtx->queue->prio)
-				prio = mtx->queue->prio;
+	if (mtx && prio < priv_mtx_prio(mtx))
+		prio = priv_mtx_prio(mtx);
+
+	for (rwl = tsk->rwl; rwl; rwl = rwl->list)
+		if (prio < priv_rwl_prio(rwl))
+			prio = priv_rwl_prio(rwl);
+
+	return prio;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_prio( tsk_t *tsk, unsigned prio )
+{
+	prio = priv_tsk_prio(tsk, prio);
 
 	if (tsk->prio != prio)
 	{
-		tsk->prio = prio;
-
 		if (tsk == System.cur)
 		{
-			tsk = tsk->obj.next;
-			if (tsk->prio > prio)
-				port_ctx_switch();
+			priv_cur_prio(tsk, prio);
 		}
 		else
 		if (tsk->id == ID_READY)
 		{
 			priv_tsk_remove(tsk);
+			tsk->prio = prio;
 			core_tsk_insert(tsk);
 		}
 		else
 		if (tsk->id == ID_DELAYED)
 		{
-			core_tsk_transfer(tsk, tsk->guard);
+			if (tsk->fifo)
+			{
+				tsk->prio = prio; // position in the FIFO queue does not depend on priority
+			}
+			else
+			{
+				void *obj = tsk->guard;
+				core_tsk_unlink(tsk, tsk->event); // the task must leave the queue with its old priority
+				tsk->prio = prio;
+				core_tsk_append(tsk, obj);
+			}
 			if (tsk->mtx.tree)
 				core_tsk_prio(tsk->mtx.tree, prio);
 		}
+		else
+		{
+			tsk->prio = prio;
+		}
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
+void core_tsk_thresh( tsk_t *tsk, unsigned thresh )
+{
+	tsk_t *nxt = IDLE.obj.next;
+
+	tsk->thresh = thresh;
+
+	if (tsk == System.cur && tsk != nxt && priv_tsk_preempt(nxt))
+		port_ctx_switch();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void core_cur_prio( unsigned prio )
 {
-	mtx_t *mtx;
 	tsk_t *tsk = System.cur;
 
-	if (prio < tsk->basic)
-		prio = tsk->basic;
-
-	for (mtx = tsk->mtx.list; mtx; mtx = mtx->list)
-		if (mtx->queue)
-			if (prio < mtx->queue->prio)
-				prio = mtx->queue->prio;
+	prio = priv_tsk_prio(tsk, prio);
 
 	if (tsk->prio != prio)
-	{
-		tsk->prio = prio;
-		tsk = tsk->obj.next;
-		if (tsk->prio > prio)
-			port_ctx_switch();
-	}
+		priv_cur_prio(tsk, prio);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -534,11 +1449,21 @@ void *core_tsk_handler( void *sp )
 
 		nxt = IDLE.obj.next;
 
-#if OS_ROBIN && HW_TIMER_SIZE == 0
-		if (cur == nxt || (nxt->slice >= (OS_FREQUENCY)/(OS_ROBIN) && (nxt->slice = 0) == 0))
+		if (cur->id == ID_READY && System.sched) // the scheduler is locked
+		{
+			System.defer = true;
+			nxt = cur;
+		}
+		else
+		if (cur != nxt && !priv_tsk_preempt(nxt)) // the current task is protected by its preemption threshold
+			nxt = cur;
+		else
+#if OS_ROBIN
+		if (cur == nxt || (nxt->quantum && nxt->slice >= nxt->quantum && (nxt->slice = 0) == 0))
 #else
 		if (cur == nxt)
 #endif
+		if (nxt != &IDLE) // the idle task is never rotated
 		{
 			priv_tsk_remove(nxt);
 			priv_tsk_insert(nxt);
@@ -562,11 +1487,21 @@ void core_sys_tick( void )
 	System.cnt++;
 	core_tmr_handler();
 	#if OS_ROBIN
-	if (++System.cur->slice >= (OS_FREQUENCY)/(OS_ROBIN))
-		core_ctx_switch();
+	core_ctx_slice(1);
 	#endif
 }
 
+/* -------------------------------------------------------------------------- */
+
+void core_sys_advance( cnt_t ticks )
+{
+	port_set_lock();
+	System.cnt += ticks;
+	port_clr_lock();
+
+	core_tmr_handler();
+}
+
 #endif
 
 /* -------------------------------------------------------------------------- */
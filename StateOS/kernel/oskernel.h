@@ -79,6 +79,30 @@ typedef     void (* FUN_t)( void );
 #define SSIZE( size ) \
  ALIGNED_SIZE( size, stk_t )
 
+// index mask of a ring buffer with capacity 'limit': (limit - 1) if 'limit' is a power of two, otherwise zero
+#define POW2MASK( limit ) \
+       ((((limit)&((limit)-1))==0)?((limit)-1):0)
+
+// 'limit' if it is a power of two, otherwise compilation error
+#define POW2( limit ) \
+       ((limit)*sizeof(char[(((limit)&((limit)-1))==0)*2-1]))
+
+// true if the ring buffer of object 'obj' uses free-running indices (index mask), resolved at compile time unless OS_RING_POW2 == 1
+#if   OS_RING_POW2 == 0
+#define POW2INDEX( obj ) \
+       (false)
+#elif OS_RING_POW2 == 1
+#define POW2INDEX( obj ) \
+       ((obj)->mask != 0)
+#else
+#define POW2INDEX( obj ) \
+       (true)
+#endif
+
+// true if ring buffer capacity 'limit' is allowed by OS_RING_POW2
+#define POW2LIMIT( limit ) \
+       (OS_RING_POW2 < 2 || (((limit)&((limit)-1))==0))
+
 /* -------------------------------------------------------------------------- */
 
 #ifdef __cplusplus
@@ -112,6 +136,12 @@ void core_ctx_init( tsk_t *tsk );
 // save status of the current process and force yield system control to the next
 void core_ctx_switch( void );
 
+// add 'ticks' to the time slice of the current task
+// force yield system control to the next process if the time slice has expired
+#if OS_ROBIN
+void core_ctx_slice( cnt_t ticks );
+#endif
+
 // save status of the current process and immediately yield system control to the next
 __STATIC_INLINE
 void core_ctx_switchNow( void )
@@ -120,6 +150,35 @@ void core_ctx_switchNow( void )
 	port_clr_lock(); port_set_barrier();
 }
 
+// lock the scheduler: context switches are deferred while the current task is ready
+__STATIC_INLINE
+void core_sch_lock( void )
+{
+	System.sched++;
+}
+
+// unlock the scheduler: force the deferred context switch when the lock is released
+__STATIC_INLINE
+void core_sch_unlock( void )
+{
+	if (--System.sched == 0 && System.defer)
+	{
+		System.defer = false;
+		port_ctx_switch();
+	}
+}
+
+// limit the priority 'prio' to the number of task priority levels
+__STATIC_INLINE
+unsigned core_prio_limit( unsigned prio )
+{
+#if OS_PRIO_LEVELS
+	if (prio >= (OS_PRIO_LEVELS))
+		prio = (OS_PRIO_LEVELS)-1;
+#endif
+	return prio;
+}
+
 // system infinite loop procedure for the current process
 __NO_RETURN
 void core_tsk_loop( void );
@@ -147,9 +206,34 @@ void core_tmr_insert( tmr_t *tmr, tid_t id );
 // remove timer 'tmr' from timers READY queue
 void core_tmr_remove( tmr_t *tmr );
 
+// extend countdown of timer 'tmr' (not greater than 'slack' ticks)
+// to expire together with another timer (or delayed task) already started
+void core_tmr_align( tmr_t *tmr, cnt_t slack );
+
+// return number of ticks until the nearest expiration of timer (or delayed task)
+// INFINITE: no timer is counting
+cnt_t core_tmr_delay( void );
+
 // timers queue handler procedure
 void core_tmr_handler( void );
 
+// enter the low-power idle state selected by the idle policy for 'delay' ticks to the nearest timer expiration
+// must be called with interrupts disabled
+// return false if the default idle state should be used
+bool core_pwr_idle( cnt_t delay );
+
+// return timer (or delayed task) following timer 'tmr' in timers READY queue
+// iteration over all started timers begins and ends with WAIT
+#if OS_TIMER_WHEEL
+tmr_t *core_tmr_next( tmr_t *tmr );
+#else
+__STATIC_INLINE
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	return (tmr_t *)((obj_t *)tmr)->next;
+}
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 // reset stack and restart the current task
@@ -164,6 +248,7 @@ void core_tsk_insert( tsk_t *tsk );
 void core_tsk_remove( tsk_t *tsk );
 
 // append task 'tsk' to the delayed queue of object 'obj'
+// tasks are queued in the priority order or, if tsk->fifo is set, in the arrival order
 void core_tsk_append( tsk_t *tsk, void *obj );
 
 // remove task 'tsk' from the delayed queue of object 'obj' with event value 'event'
@@ -226,10 +311,22 @@ tsk_t *core_one_wakeup( void *obj, unsigned event );
 // force context switch if priority of any resumed task is greater then priority of the current task and kernel works in preemptive mode
 void core_all_wakeup( void *obj, unsigned event );
 
+// insert mutex 'mtx' into the list of mutexes held by its owner or move it within this list
+// the list is sorted by priority required by the mutexes (the priority ceiling or the priority of the first waiting task)
+void core_mtx_sort( mtx_t *mtx );
+
+// set task 'tsk' as the owner of mutex 'mtx' and insert the mutex into the list of mutexes held by the task
+// apply the priority ceiling of the mutex to the task
+void core_mtx_link( mtx_t *mtx, tsk_t *tsk );
+
 // set task 'tsk' priority
 // force context switch if new priority of task 'tsk' is greater then priority of current task and kernel works in preemptive mode
 void core_tsk_prio( tsk_t *tsk, unsigned prio );
 
+// set task 'tsk' preemption threshold
+// force context switch if the first task in ready queue can preempt the current task with the new threshold
+void core_tsk_thresh( tsk_t *tsk, unsigned thresh );
+
 // set the current task priority
 // force context switch if new priority of the current task is less then priority of next task in ready queue and kernel works in preemptive mode
 void core_cur_prio( unsigned prio );
@@ -242,6 +339,102 @@ void *core_tsk_handler( void *sp );
 
 /* -------------------------------------------------------------------------- */
 
+// ring buffer indices
+// core_buf_*: indices are positions in the buffer wrapped at 'limit' (any capacity)
+// core_pow2_*: indices are free-running and the position is (index & mask) (capacity being a power of two)
+// each function serves only one of the schemes, so the free-running path contains no wrap test
+
+// return index 'idx' advanced by 'size' in the ring buffer of 'limit' elements
+__STATIC_INLINE
+unsigned core_buf_add( unsigned limit, unsigned idx, unsigned size )
+{
+	idx += size;
+	if (idx >= limit) idx -= limit;
+	return idx;
+}
+
+// copy 'size' bytes from the ring buffer 'buf' of 'limit' bytes, starting at index 'idx', to the buffer 'data'
+// the transfer is split into at most two contiguous segments copied with memcpy
+// return the index following the last copied byte
+__STATIC_INLINE
+unsigned core_buf_get( const char *buf, unsigned limit, unsigned idx, char *data, unsigned size )
+{
+	unsigned seg = limit - idx;
+
+	if (size < seg)
+	{
+		memcpy(data, buf + idx, size);
+		return idx + size;
+	}
+
+	memcpy(data, buf + idx, seg);
+	memcpy(data + seg, buf, size - seg);
+	return size - seg;
+}
+
+// copy 'size' bytes from the buffer 'data' to the ring buffer 'buf' of 'limit' bytes, starting at index 'idx'
+// the transfer is split into at most two contiguous segments copied with memcpy
+// return the index following the last copied byte
+__STATIC_INLINE
+unsigned core_buf_put( char *buf, unsigned limit, unsigned idx, const char *data, unsigned size )
+{
+	unsigned seg = limit - idx;
+
+	if (size < seg)
+	{
+		memcpy(buf + idx, data, size);
+		return idx + size;
+	}
+
+	memcpy(buf + idx, data, seg);
+	memcpy(buf, data + seg, size - seg);
+	return size - seg;
+}
+
+// copy 'size' bytes from the ring buffer 'buf' of (mask + 1) bytes, starting at the free-running index 'idx', to the buffer 'data'
+// return the index following the last copied byte
+__STATIC_INLINE
+unsigned core_pow2_get( const char *buf, unsigned mask, unsigned idx, char *data, unsigned size )
+{
+	unsigned pos = idx & mask;
+	unsigned seg = mask + 1 - pos;
+
+	if (size < seg)
+	{
+		memcpy(data, buf + pos, size);
+	}
+	else
+	{
+		memcpy(data, buf + pos, seg);
+		memcpy(data + seg, buf, size - seg);
+	}
+
+	return idx + size;
+}
+
+// copy 'size' bytes from the buffer 'data' to the ring buffer 'buf' of (mask + 1) bytes, starting at the free-running index 'idx'
+// return the index following the last copied byte
+__STATIC_INLINE
+unsigned core_pow2_put( char *buf, unsigned mask, unsigned idx, const char *data, unsigned size )
+{
+	unsigned pos = idx & mask;
+	unsigned seg = mask + 1 - pos;
+
+	if (size < seg)
+	{
+		memcpy(buf + pos, data, size);
+	}
+	else
+	{
+		memcpy(buf + pos, data, seg);
+		memcpy(buf, data + seg, size - seg);
+	}
+
+	return idx + size;
+}
+
+/* -------------------------------------------------------------------------- */
+
 // return current system time in tick-less mode
 #if HW_TIMER_SIZE < OS_TIMER_SIZE // because of CSMCC
 cnt_t port_sys_time( void );
@@ -258,9 +451,20 @@ cnt_t core_sys_time( void )
 #endif
 }
 
+// suppress system timer interrupts for up to 'ticks' ticks and wait for interrupt in non-tick-less mode
+// must be called with interrupts disabled
+// return the number of elapsed ticks not signalled by the system timer interrupt
+#if HW_TIMER_SIZE == 0 && OS_TICKLESS
+cnt_t port_tck_sleep( cnt_t ticks );
+#endif
+
 // internal handler of system timer
 #if HW_TIMER_SIZE == 0
 void core_sys_tick( void );
+
+// advance system timer counter by 'ticks' ticks suppressed by the port and handle expired timers
+// must be called outside the critical section (the timer handler unmasks interrupts on exit)
+void core_sys_advance( cnt_t ticks );
 #else
 __STATIC_INLINE
 void core_sys_tick( void )
@@ -30,6 +30,7 @@
  ******************************************************************************/
 
 #include "inc/osconditionvariable.h"
+#include "inc/ostask.h"
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
@@ -97,6 +98,7 @@ unsigned priv_cnd_wait( cnd_t *cnd, mtx_t *mtx, cnt_t time, unsigned(*wait)(void
 /* -------------------------------------------------------------------------- */
 {
 	unsigned event;
+	bool     own;
 
 	assert(!port_isr_inside());
 	assert(cnd);
@@ -104,9 +106,19 @@ unsigned priv_cnd_wait( cnd_t *cnd, mtx_t *mtx, cnt_t time, unsigned(*wait)(void
 
 	sys_lock();
 	{
-		if ((event = mtx_give(mtx))   == E_SUCCESS)
-		if ((event = wait(cnd, time)) == E_SUCCESS)
-		     event = mtx_wait(mtx);
+		if ((event = mtx_give(mtx)) == E_SUCCESS)
+		{
+			// the recursive mutex is still owned by the task, its lock count must be restored by mtx_wait
+			own = mtx->owner == System.cur;
+
+			System.cur->tmp.cnd.mtx = mtx;
+			event = wait(cnd, time);
+			System.cur->mtx.tree = 0;
+
+			// the task could have been moved to the mutex queue and the mutex handed over to it
+			if (event == E_SUCCESS && (own || mtx->owner != System.cur))
+				event = mtx_wait(mtx);
+		}
 	}
 	sys_unlock();
 
@@ -127,16 +139,57 @@ unsigned cnd_waitUntil( cnd_t *cnd, mtx_t *mtx, cnt_t time )
 	return priv_cnd_wait(cnd, mtx, time, core_tsk_waitUntil);
 }
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_cnd_transfer( tsk_t *tsk, mtx_t *mtx )
+/* -------------------------------------------------------------------------- */
+{
+	// move the signalled task from the condition variable queue directly to the mutex queue (wait morphing);
+	// the mutex is waited for indefinitely, as in the mtx_wait function
+	core_tsk_unlink(tsk, E_SUCCESS);
+	core_tmr_remove((tmr_t *)tsk);
+	tsk->delay = INFINITE;
+	core_tmr_insert((tmr_t *)tsk, ID_DELAYED);
+
+	if (mtx->owner && (mtx->mode & mtxPrioProtect) == 0)
+	{
+		if (mtx->owner->prio < tsk->prio)
+			core_tsk_prio(mtx->owner, tsk->prio);
+
+		tsk->mtx.tree = mtx->owner;
+	}
+
+	core_tsk_append(tsk, mtx);
+}
+
 /* -------------------------------------------------------------------------- */
 void cnd_give( cnd_t *cnd, bool all )
 /* -------------------------------------------------------------------------- */
 {
+	tsk_t *tsk;
+	mtx_t *mtx;
+
 	assert(cnd);
 
 	sys_lock();
 	{
-		if (all) core_all_wakeup(cnd, E_SUCCESS);
-		else     core_one_wakeup(cnd, E_SUCCESS);
+		while ((tsk = cnd->queue) != 0)
+		{
+			mtx = tsk->tmp.cnd.mtx;
+
+			// only the task that can lock the mutex is woken up, the free mutex is handed over to it;
+			// the others are transferred to the mutex queue and released one by one by the mutex owner;
+			// the task that still owns the recursive mutex is always woken up
+			if (mtx->owner == 0 && mtx->queue == 0)
+				core_mtx_link(mtx, tsk);
+
+			if (mtx->owner == tsk)
+				core_tsk_wakeup(tsk, E_SUCCESS);
+			else
+				priv_cnd_transfer(tsk, mtx);
+
+			if (!all) break;
+		}
 	}
 	sys_unlock();
 }
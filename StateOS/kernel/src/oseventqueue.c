@@ -40,6 +40,7 @@ void evq_init( evq_t *evq, unsigned limit, unsigned *data )
 	assert(!port_isr_inside());
 	assert(evq);
 	assert(limit);
+	assert(POW2LIMIT(limit));
 	assert(data);
 
 	sys_lock();
@@ -48,6 +49,7 @@ void evq_init( evq_t *evq, unsigned limit, unsigned *data )
 
 		evq->limit = limit;
 		evq->data  = data;
+		evq->mask  = POW2MASK(limit);
 	}
 	sys_unlock();
 }
@@ -72,6 +74,22 @@ evq_t *evq_create( unsigned limit )
 	return evq;
 }
 
+/* -------------------------------------------------------------------------- */
+void evq_setMode( evq_t *evq, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(evq);
+
+	sys_lock();
+	{
+		assert(evq->queue == 0);
+
+		evq->mode = mode;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void evq_kill( evq_t *evq )
 /* -------------------------------------------------------------------------- */
@@ -110,9 +128,16 @@ unsigned priv_evq_get( evq_t *evq )
 	unsigned event;
 	unsigned i = evq->head;
 
-	event = evq->data[i++];
-
-	evq->head = (i < evq->limit) ? i : 0;
+	if (POW2INDEX(evq)) // free-running index
+	{
+		event = evq->data[i++ & evq->mask];
+		evq->head = i;
+	}
+	else
+	{
+		event = evq->data[i++];
+		evq->head = (i < evq->limit) ? i : 0;
+	}
 	evq->count--;
 
 	return event;
@@ -125,9 +150,16 @@ void priv_evq_put( evq_t *evq, unsigned event )
 {
 	unsigned i = evq->tail;
 
-	evq->data[i++] = event;
-
-	evq->tail = (i < evq->limit) ? i : 0;
+	if (POW2INDEX(evq)) // free-running index
+	{
+		evq->data[i++ & evq->mask] = event;
+		evq->tail = i;
+	}
+	else
+	{
+		evq->data[i++] = event;
+		evq->tail = (i < evq->limit) ? i : 0;
+	}
 	evq->count++;
 }
 
@@ -175,6 +207,7 @@ unsigned priv_evq_wait( evq_t *evq, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 		}
 		else
 		{
+			System.cur->fifo = evq->mode == evqFifo;
 			event = wait(evq, time);
 		}
 	}
@@ -241,6 +274,7 @@ unsigned priv_evq_send( evq_t *evq, unsigned data, cnt_t time, unsigned(*wait)(v
 		}
 		else
 		{
+			System.cur->fifo = evq->mode == evqFifo;
 			event = wait(evq, time);
 		}
 	}
@@ -279,7 +313,7 @@ unsigned evq_push( evq_t *evq, unsigned data )
 			if (evq->count > evq->limit)
 			{
 				evq->count = evq->limit;
-				evq->head = evq->tail;
+				evq->head = POW2INDEX(evq) ? evq->head + 1 : core_buf_add(evq->limit, evq->head, 1);
 			}
 			if (evq->queue)
 				core_one_wakeup(evq, priv_evq_get(evq));
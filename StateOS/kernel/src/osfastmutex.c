@@ -30,10 +30,11 @@
  ******************************************************************************/
 
 #include "inc/osfastmutex.h"
+#include "inc/ostask.h"
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
-void mut_init( mut_t *mut )
+void mut_init( mut_t *mut, unsigned mode )
 /* -------------------------------------------------------------------------- */
 {
 	assert(!port_isr_inside());
@@ -42,6 +43,8 @@ void mut_init( mut_t *mut )
 	sys_lock();
 	{
 		memset(mut, 0, sizeof(mut_t));
+
+		mut->mode = mode;
 	}
 	sys_unlock();
 }
@@ -57,7 +60,7 @@ mut_t *mut_create( void )
 	sys_lock();
 	{
 		mut = core_sys_alloc(sizeof(mut_t));
-		mut_init(mut);
+		mut_init(mut, mutHandoff);
 		mut->res = mut;
 	}
 	sys_unlock();
@@ -91,6 +94,44 @@ void mut_delete( mut_t *mut )
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+#ifdef OS_EXCLUSIVE
+/* -------------------------------------------------------------------------- */
+static
+bool priv_mut_takeFast( mut_t *mut )
+/* -------------------------------------------------------------------------- */
+{
+	volatile unsigned *owner = (volatile unsigned *)&mut->owner;
+
+	do
+	{
+		if (port_ldrex(owner) != 0) // locked: use the kernel lock
+			return false;
+	}
+	while (!port_strex(owner, (size_t)System.cur));
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+bool priv_mut_giveFast( mut_t *mut )
+/* -------------------------------------------------------------------------- */
+{
+	volatile unsigned *owner = (volatile unsigned *)&mut->owner;
+
+	do
+	{
+		if (port_ldrex(owner) != (size_t)System.cur || mut->queue) // not the owner or any task waiting: use the kernel lock
+			return false;
+	}
+	while (!port_strex(owner, 0));
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+#endif//OS_EXCLUSIVE
 /* -------------------------------------------------------------------------- */
 static
 unsigned priv_mut_wait( mut_t *mut, cnt_t time, unsigned(*wait)(void*,cnt_t) )
@@ -101,6 +142,10 @@ unsigned priv_mut_wait( mut_t *mut, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 	assert(!port_isr_inside());
 	assert(mut);
 
+#ifdef OS_EXCLUSIVE
+	if (priv_mut_takeFast(mut))
+		return E_SUCCESS;
+#endif
 	sys_lock();
 	{
 		if (mut->owner == 0)
@@ -111,7 +156,24 @@ unsigned priv_mut_wait( mut_t *mut, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 		else
 		if (mut->owner != System.cur)
 		{
-			event = wait(mut, time);
+			for (;;)
+			{
+				event = wait(mut, time);
+
+				if (event != E_SUCCESS || mut->mode != mutBarging)
+					break;
+
+				// competitive release: the fast mutex was released, but not handed over
+				if (mut->owner == 0)
+				{
+					mut->owner = System.cur;
+					break;
+				}
+
+				// the fast mutex was taken by another task; wait again until the original deadline
+				wait = core_tsk_waitNext;
+				time = System.cur->delay;
+			}
 		}
 	}
 	sys_unlock();
@@ -142,11 +204,23 @@ unsigned mut_give( mut_t *mut )
 	assert(!port_isr_inside());
 	assert(mut);
 
+#ifdef OS_EXCLUSIVE
+	if (priv_mut_giveFast(mut))
+		return E_SUCCESS;
+#endif
 	sys_lock();
 	{
 		if (mut->owner == System.cur)
 		{
-			mut->owner = core_one_wakeup(mut, E_SUCCESS);
+			if (mut->mode == mutBarging)
+			{
+				mut->owner = 0;
+				core_one_wakeup(mut, E_SUCCESS);
+			}
+			else
+			{
+				mut->owner = core_one_wakeup(mut, E_SUCCESS);
+			}
 			event = E_SUCCESS;
 		}
 	}
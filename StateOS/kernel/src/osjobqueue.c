@@ -40,6 +40,7 @@ void job_init( job_t *job, unsigned limit, fun_t **data )
 	assert(!port_isr_inside());
 	assert(job);
 	assert(limit);
+	assert(POW2LIMIT(limit));
 	assert(data);
 
 	sys_lock();
@@ -48,6 +49,7 @@ void job_init( job_t *job, unsigned limit, fun_t **data )
 
 		job->limit = limit;
 		job->data  = data;
+		job->mask  = POW2MASK(limit);
 	}
 	sys_unlock();
 }
@@ -72,6 +74,22 @@ job_t *job_create( unsigned limit )
 	return job;
 }
 
+/* -------------------------------------------------------------------------- */
+void job_setMode( job_t *job, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(job);
+
+	sys_lock();
+	{
+		assert(job->queue == 0);
+
+		job->mode = mode;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void job_kill( job_t *job )
 /* -------------------------------------------------------------------------- */
@@ -110,8 +128,16 @@ fun_t *priv_job_get( job_t *job )
 	fun_t  * fun;
 	unsigned i = job->head;
 
-	fun = job->data[i++];
-	job->head = (i < job->limit) ? i : 0;
+	if (POW2INDEX(job)) // free-running index
+	{
+		fun = job->data[i++ & job->mask];
+		job->head = i;
+	}
+	else
+	{
+		fun = job->data[i++];
+		job->head = (i < job->limit) ? i : 0;
+	}
 	job->count--;
 
 	return fun;
@@ -124,9 +150,16 @@ void priv_job_put( job_t *job, fun_t *fun )
 {
 	unsigned i = job->tail;
 
-	job->data[i++] = fun;
-
-	job->tail = (i < job->limit) ? i : 0;
+	if (POW2INDEX(job)) // free-running index
+	{
+		job->data[i++ & job->mask] = fun;
+		job->tail = i;
+	}
+	else
+	{
+		job->data[i++] = fun;
+		job->tail = (i < job->limit) ? i : 0;
+	}
 	job->count++;
 }
 
@@ -178,6 +211,7 @@ unsigned priv_job_wait( job_t *job, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 		}
 		else
 		{
+			System.cur->fifo = job->mode == jobFifo;
 			event = wait(job, time);
 		}
 
@@ -252,6 +286,7 @@ unsigned priv_job_send( job_t *job, fun_t *fun, cnt_t time, unsigned(*wait)(void
 		else
 		{
 			System.cur->tmp.job.fun = fun;
+			System.cur->fifo = job->mode == jobFifo;
 			event = wait(job, time);
 		}
 	}
@@ -292,7 +327,7 @@ unsigned job_push( job_t *job, fun_t *fun )
 			if (job->count > job->limit)
 			{
 				job->count = job->limit;
-				job->head = job->tail;
+				job->head = POW2INDEX(job) ? job->head + 1 : core_buf_add(job->limit, job->head, 1);
 			}
 			tsk = core_one_wakeup(job, E_SUCCESS);
 			if (tsk) tsk->tmp.job.fun = priv_job_get(job);
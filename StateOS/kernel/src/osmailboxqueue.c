@@ -40,6 +40,7 @@ void box_init( box_t *box, unsigned limit, void *data, unsigned size )
 	assert(!port_isr_inside());
 	assert(box);
 	assert(limit);
+	assert(POW2LIMIT(limit));
 	assert(data);
 	assert(size);
 
@@ -50,6 +51,7 @@ void box_init( box_t *box, unsigned limit, void *data, unsigned size )
 		box->limit = limit * size;
 		box->data  = data;
 		box->size  = size;
+		box->mask  = POW2MASK(limit);
 	}
 	sys_unlock();
 }
@@ -75,6 +77,22 @@ box_t *box_create( unsigned limit, unsigned size )
 	return box;
 }
 
+/* -------------------------------------------------------------------------- */
+void box_setMode( box_t *box, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(box);
+
+	sys_lock();
+	{
+		assert(box->queue == 0);
+
+		box->mode = mode;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void box_kill( box_t *box )
 /* -------------------------------------------------------------------------- */
@@ -110,6 +128,9 @@ static
 unsigned priv_box_count( box_t *box )
 /* -------------------------------------------------------------------------- */
 {
+	if (POW2INDEX(box)) // free-running index of the element
+		return box->tail - box->head;
+
 	return box->count / box->size;
 }
 
@@ -118,6 +139,9 @@ static
 unsigned priv_box_space( box_t *box )
 /* -------------------------------------------------------------------------- */
 {
+	if (POW2INDEX(box)) // free-running index of the element
+		return box->mask + 1 - (box->tail - box->head);
+
 	return (box->limit - box->count) / box->size;
 }
 
@@ -127,8 +151,15 @@ void priv_box_skip( box_t *box )
 /* -------------------------------------------------------------------------- */
 {
 	box->count -= box->size;
-	box->head  += box->size;
-	if (box->head == box->limit) box->head = 0;
+	if (POW2INDEX(box)) // free-running index of the element
+	{
+		box->head++;
+	}
+	else
+	{
+		box->head += box->size;
+		if (box->head == box->limit) box->head = 0;
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -136,13 +167,19 @@ static
 void priv_box_get( box_t *box, char *data )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = box->head;
-	unsigned j = 0;
-
-	do data[j++] = box->data[i++]; while (j < box->size);
-
-	box->head = (i < box->limit) ? i : 0;
-	box->count -= j;
+	// the mailbox never wraps inside an element, the element is copied as a single segment
+	if (POW2INDEX(box)) // free-running index of the element
+	{
+		memcpy(data, box->data + (box->head & box->mask) * box->size, box->size);
+		box->head++;
+	}
+	else
+	{
+		memcpy(data, box->data + box->head, box->size);
+		box->head += box->size;
+		if (box->head == box->limit) box->head = 0;
+	}
+	box->count -= box->size;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -150,13 +187,19 @@ static
 void priv_box_put( box_t *box, const char *data )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = box->tail;
-	unsigned j = 0;
-
-	do box->data[i++] = data[j++]; while (j < box->size);
-
-	box->tail = (i < box->limit) ? i : 0;
-	box->count += j;
+	// the mailbox never wraps inside an element, the element is copied as a single segment
+	if (POW2INDEX(box)) // free-running index of the element
+	{
+		memcpy(box->data + (box->tail & box->mask) * box->size, data, box->size);
+		box->tail++;
+	}
+	else
+	{
+		memcpy(box->data + box->tail, data, box->size);
+		box->tail += box->size;
+		if (box->tail == box->limit) box->tail = 0;
+	}
+	box->count += box->size;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -226,6 +269,7 @@ unsigned priv_box_wait( box_t *box, void *data, cnt_t time, unsigned(*wait)(void
 		else
 		{
 			System.cur->tmp.box.data.in = data;
+			System.cur->fifo = box->mode == boxFifo;
 			event = wait(box, time);
 		}
 	}
@@ -291,6 +335,7 @@ unsigned priv_box_send( box_t *box, const void *data, cnt_t time, unsigned(*wait
 		else
 		{
 			System.cur->tmp.box.data.out = data;
+			System.cur->fifo = box->mode == boxFifo;
 			event = wait(box, time);
 		}
 	}
@@ -40,6 +40,7 @@ void msg_init( msg_t *msg, unsigned limit, void *data )
 	assert(!port_isr_inside());
 	assert(msg);
 	assert(limit);
+	assert(POW2LIMIT(limit));
 	assert(data);
 
 	sys_lock();
@@ -48,6 +49,7 @@ void msg_init( msg_t *msg, unsigned limit, void *data )
 
 		msg->limit = limit;
 		msg->data  = data;
+		msg->mask  = POW2MASK(limit);
 	}
 	sys_unlock();
 }
@@ -72,6 +74,24 @@ msg_t *msg_create( unsigned limit )
 	return msg;
 }
 
+/* -------------------------------------------------------------------------- */
+void msg_setMode( msg_t *msg, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(msg);
+	assert(mode != msgSPSC || msg->mask);
+
+	sys_lock();
+	{
+		assert(msg->queue == 0);
+		assert(msg->count == 0 && msg->tail == msg->head); // the messages are stored differently in the msgSPSC mode
+
+		msg->mode = mode;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void msg_kill( msg_t *msg )
 /* -------------------------------------------------------------------------- */
@@ -127,8 +147,7 @@ void priv_msg_skip( msg_t *msg )
 /* -------------------------------------------------------------------------- */
 {
 	msg->count -= msg->size;
-	msg->head  += msg->size;
-	if (msg->head >= msg->limit) msg->head -= msg->limit;
+	msg->head = POW2INDEX(msg) ? msg->head + msg->size : core_buf_add(msg->limit, msg->head, msg->size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -136,16 +155,11 @@ static
 void priv_msg_get( msg_t *msg, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i;
-
-	msg->count -= size;;
-	i = msg->head;
-	while (size--)
-	{
-		*data++ = msg->data[i++];
-		if (i >= msg->limit) i = 0;
-	}
-	msg->head = i;
+	msg->count -= size;
+	if (POW2INDEX(msg))
+		msg->head = core_pow2_get(msg->data, msg->mask, msg->head, data, size);
+	else
+		msg->head = core_buf_get(msg->data, msg->limit, msg->head, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -153,16 +167,11 @@ static
 void priv_msg_put( msg_t *msg, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i;
-
 	msg->count += size;
-	i = msg->tail;
-	while (size--)
-	{
-		msg->data[i++] = *data++;
-		if (i >= msg->limit) i = 0;
-	}
-	msg->tail = i;
+	if (POW2INDEX(msg))
+		msg->tail = core_pow2_put(msg->data, msg->mask, msg->tail, data, size);
+	else
+		msg->tail = core_buf_put(msg->data, msg->limit, msg->tail, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -246,6 +255,7 @@ unsigned msg_take( msg_t *msg, void *data, unsigned size )
 	unsigned len = 0;
 
 	assert(msg);
+	assert(msg->mode != msgSPSC);
 	assert(data);
 
 	sys_lock();
@@ -267,6 +277,7 @@ unsigned priv_msg_wait( msg_t *msg, char *data, unsigned size, cnt_t time, unsig
 
 	assert(!port_isr_inside());
 	assert(msg);
+	assert(msg->mode != msgSPSC);
 	assert(data);
 
 	sys_lock();
@@ -315,6 +326,7 @@ unsigned msg_give( msg_t *msg, const void *data, unsigned size )
 	unsigned len = 0;
 
 	assert(msg);
+	assert(msg->mode != msgSPSC);
 	assert(data);
 
 	sys_lock();
@@ -336,6 +348,7 @@ unsigned priv_msg_send( msg_t *msg, const char *data, unsigned size, cnt_t time,
 
 	assert(!port_isr_inside());
 	assert(msg);
+	assert(msg->mode != msgSPSC);
 	assert(data);
 
 	sys_lock();
@@ -382,6 +395,7 @@ unsigned msg_push( msg_t *msg, const void *data, unsigned size )
 	unsigned len = 0;
 
 	assert(msg);
+	assert(msg->mode != msgSPSC);
 	assert(data);
 
 	sys_lock();
@@ -401,6 +415,190 @@ unsigned msg_push( msg_t *msg, const void *data, unsigned size )
 	return len;
 }
 
+/* -------------------------------------------------------------------------- */
+// single-producer/single-consumer functions, only for the message buffer object in the msgSPSC mode
+// the capacity is a power of two, the head index is written only by the consumer and the tail index only by the producer;
+// every message is stored with its size, the counter and the size of the first message are not updated;
+// the data is transfered without the kernel lock, the lock is taken only when the other side may wait in the queue
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_takeSPSC( msg_t *msg, void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len = 0;
+	unsigned head;
+
+	assert(msg);
+	assert(msg->mode == msgSPSC);
+	assert(data);
+
+	head = msg->head;
+
+	if (head != msg->tail)
+	{
+		port_mem_barrier(); // read the message after the tail index
+		head = core_pow2_get(msg->data, msg->mask, head, (void *)&len, sizeof(unsigned));
+
+		if (len <= size)
+		{
+			head = core_pow2_get(msg->data, msg->mask, head, data, len);
+			port_mem_barrier(); // release the space after the message has been read
+			msg->head = head;
+			port_mem_barrier(); // check the queue after the head index has been updated
+
+			// only the producer can wait in the queue
+			if (msg->queue != 0)
+			{
+				sys_lock();
+				{
+					if (msg->queue != 0 && msg->queue->tmp.msg.size + sizeof(unsigned) <= msg->limit - (msg->tail - msg->head))
+						core_tsk_wakeup(msg->queue, E_SUCCESS);
+				}
+				sys_unlock();
+			}
+		}
+		else
+		{
+			len = 0;
+		}
+	}
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_msg_waitSPSC( msg_t *msg, char *data, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len;
+	unsigned event = E_SUCCESS;
+
+	assert(!port_isr_inside());
+
+	len = msg_takeSPSC(msg, data, size);
+
+	if (len == 0 && size > 0)
+	{
+		sys_lock();
+		{
+			if (msg->head == msg->tail)
+			{
+				System.cur->tmp.msg.data.in = data;
+				System.cur->tmp.msg.size = size;
+				event = wait(msg, time);
+			}
+		}
+		sys_unlock();
+
+		// the producer has woken the task when a message became available
+		if (event == E_SUCCESS)
+			len = msg_takeSPSC(msg, data, size);
+	}
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_waitSPSCFor( msg_t *msg, void *data, unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_msg_waitSPSC(msg, data, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_waitSPSCUntil( msg_t *msg, void *data, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_msg_waitSPSC(msg, data, size, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_giveSPSC( msg_t *msg, const void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len = 0;
+	unsigned tail;
+
+	assert(msg);
+	assert(msg->mode == msgSPSC);
+	assert(data);
+
+	tail = msg->tail;
+
+	if (size > 0 && size <= msg->limit && size + sizeof(unsigned) <= msg->limit - (tail - msg->head))
+	{
+		port_mem_barrier(); // write the message after the head index
+		tail = core_pow2_put(msg->data, msg->mask, tail, (const void *)&size, sizeof(unsigned));
+		tail = core_pow2_put(msg->data, msg->mask, tail, data, size);
+		port_mem_barrier(); // publish the message after it has been written
+		msg->tail = tail;
+		port_mem_barrier(); // check the queue after the tail index has been updated
+
+		// only the consumer can wait in the queue
+		if (msg->queue != 0)
+		{
+			sys_lock();
+			{
+				if (msg->queue != 0)
+					core_tsk_wakeup(msg->queue, E_SUCCESS);
+			}
+			sys_unlock();
+		}
+
+		len = size;
+	}
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_msg_sendSPSC( msg_t *msg, const char *data, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len;
+	unsigned event = E_SUCCESS;
+
+	assert(!port_isr_inside());
+
+	len = msg_giveSPSC(msg, data, size);
+
+	if (len == 0 && size > 0 && size <= msg->limit && size + sizeof(unsigned) <= msg->limit)
+	{
+		sys_lock();
+		{
+			if (size + sizeof(unsigned) > msg->limit - (msg->tail - msg->head))
+			{
+				System.cur->tmp.msg.data.out = data;
+				System.cur->tmp.msg.size = size;
+				event = wait(msg, time);
+			}
+		}
+		sys_unlock();
+
+		// the consumer has woken the task when the space became available
+		if (event == E_SUCCESS)
+			len = msg_giveSPSC(msg, data, size);
+	}
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_sendSPSCFor( msg_t *msg, const void *data, unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_msg_sendSPSC(msg, data, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned msg_sendSPSCUntil( msg_t *msg, const void *data, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_msg_sendSPSC(msg, data, size, time, core_tsk_waitUntil);
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned msg_count( msg_t *msg )
 /* -------------------------------------------------------------------------- */
@@ -411,7 +609,14 @@ unsigned msg_count( msg_t *msg )
 
 	sys_lock();
 	{
-		cnt = priv_msg_count(msg);
+		// in the msgSPSC mode the counter is not updated and every message is stored with its size
+		if (msg->mode != msgSPSC)
+			cnt = priv_msg_count(msg);
+		else
+		if (msg->tail != msg->head)
+			core_pow2_get(msg->data, msg->mask, msg->head, (void *)&cnt, sizeof(unsigned));
+		else
+			cnt = 0;
 	}
 	sys_unlock();
 
@@ -428,7 +633,14 @@ unsigned msg_space( msg_t *msg )
 
 	sys_lock();
 	{
-		cnt = priv_msg_space(msg);
+		// in the msgSPSC mode the counter is not updated and every message is stored with its size
+		if (msg->mode == msgSPSC)
+		{
+			cnt = msg->limit - (msg->tail - msg->head);
+			cnt = (cnt > sizeof(unsigned)) ? cnt - sizeof(unsigned) : 0;
+		}
+		else
+			cnt = priv_msg_space(msg);
 	}
 	sys_unlock();
 
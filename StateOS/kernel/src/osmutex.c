@@ -34,7 +34,7 @@
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
-void mtx_init( mtx_t *mtx )
+void mtx_init( mtx_t *mtx, unsigned mode, unsigned prio )
 /* -------------------------------------------------------------------------- */
 {
 	assert(!port_isr_inside());
@@ -43,6 +43,9 @@ void mtx_init( mtx_t *mtx )
 	sys_lock();
 	{
 		memset(mtx, 0, sizeof(mtx_t));
+
+		mtx->mode = mode;
+		mtx->prio = core_prio_limit(prio);
 	}
 	sys_unlock();
 }
@@ -58,7 +61,7 @@ mtx_t *mtx_create( void )
 	sys_lock();
 	{
 		mtx = core_sys_alloc(sizeof(mtx_t));
-		mtx_init(mtx);
+		mtx_init(mtx, mtxPrioInherit, 0);
 		mtx->res = mtx;
 	}
 	sys_unlock();
@@ -67,8 +70,7 @@ mtx_t *mtx_create( void )
 }
 
 /* -------------------------------------------------------------------------- */
-static
-void priv_mtx_link( mtx_t *mtx, tsk_t *tsk )
+void core_mtx_link( mtx_t *mtx, tsk_t *tsk )
 /* -------------------------------------------------------------------------- */
 {
 	assert(mtx);
@@ -77,8 +79,10 @@ void priv_mtx_link( mtx_t *mtx, tsk_t *tsk )
 
 	if (tsk)
 	{
-		mtx->list = tsk->mtx.list;
-		tsk->mtx.list = mtx;
+		core_mtx_sort(mtx);
+
+		if ((mtx->mode & mtxPrioProtect) && tsk->prio < mtx->prio)
+			core_tsk_prio(tsk, mtx->prio);
 	}
 }
 
@@ -154,7 +158,7 @@ unsigned priv_mtx_wait( mtx_t *mtx, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 	{
 		if (mtx->owner == 0)
 		{
-			priv_mtx_link(mtx, System.cur);
+			core_mtx_link(mtx, System.cur);
 			event = E_SUCCESS;
 		}
 		else
@@ -168,12 +172,38 @@ unsigned priv_mtx_wait( mtx_t *mtx, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 		}
 		else
 		{
-			if (mtx->owner->prio < System.cur->prio)
-				core_tsk_prio(mtx->owner, System.cur->prio);
-
-			System.cur->mtx.tree = mtx->owner;
-			event = wait(mtx, time);
-			System.cur->mtx.tree = 0;
+			for (;;)
+			{
+				if (mtx->mode & mtxPrioProtect)
+				{
+					assert(System.cur->basic <= mtx->prio);
+
+					event = wait(mtx, time);
+				}
+				else
+				{
+					if (mtx->owner->prio < System.cur->prio)
+						core_tsk_prio(mtx->owner, System.cur->prio);
+
+					System.cur->mtx.tree = mtx->owner;
+					event = wait(mtx, time);
+					System.cur->mtx.tree = 0;
+				}
+
+				if (event != E_SUCCESS || (mtx->mode & mtxBarging) == 0)
+					break;
+
+				// competitive release: the mutex was released, but not handed over
+				if (mtx->owner == 0)
+				{
+					core_mtx_link(mtx, System.cur);
+					break;
+				}
+
+				// the mutex was taken by another task; wait again until the original deadline
+				wait = core_tsk_waitNext;
+				time = System.cur->delay;
+			}
 		}
 	}
 	sys_unlock();
@@ -215,7 +245,10 @@ unsigned mtx_give( mtx_t *mtx )
 			else
 			{
 				priv_mtx_unlink(mtx);
-				priv_mtx_link(mtx, core_one_wakeup(mtx, E_SUCCESS));
+				if (mtx->mode & mtxBarging)
+					core_one_wakeup(mtx, E_SUCCESS);
+				else
+					core_mtx_link(mtx, core_one_wakeup(mtx, E_SUCCESS));
 			}
 
 			event = E_SUCCESS;
@@ -0,0 +1,242 @@
+/******************************************************************************
+
+    @file    StateOS: ospower.c
+    @author  Rajmund Szymanski
+    @date    03.08.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/ospower.h"
+#include "inc/oscriticalsection.h"
+
+/* -------------------------------------------------------------------------- */
+
+static lat_t *LATENCY = 0;        // registered latency budget requests
+static cnt_t  BUDGET  = INFINITE; // the smallest of registered latency budgets
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_pwr_remove( pwr_t *pwr )
+{
+	pwr_t **ptr;
+
+	for (ptr = &System.pwr; *ptr; ptr = &(*ptr)->next)
+	{
+		if (*ptr == pwr)
+		{
+			*ptr = pwr->next;
+			break;
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+void pwr_init( pwr_t *pwr, cnt_t latency, cnt_t residency, fun_pwr_enter *enter, fun_pwr_leave *leave )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(pwr);
+	assert(enter);
+
+	sys_lock();
+	{
+		priv_pwr_remove(pwr); // the object may be still registered
+
+		memset(pwr, 0, sizeof(pwr_t));
+
+		pwr->latency   = latency;
+		pwr->residency = residency;
+		pwr->enter     = enter;
+		pwr->leave     = leave;
+	}
+	sys_unlock();
+}
+
+
+/* -------------------------------------------------------------------------- */
+void pwr_register( pwr_t *pwr )
+/* -------------------------------------------------------------------------- */
+{
+	pwr_t **ptr;
+
+	assert(!port_isr_inside());
+	assert(pwr);
+	assert(pwr->enter);
+
+	sys_lock();
+	{
+		priv_pwr_remove(pwr);
+
+		for (ptr = &System.pwr; *ptr && (*ptr)->latency <= pwr->latency; ptr = &(*ptr)->next);
+		pwr->next = *ptr;
+		*ptr = pwr;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void pwr_unregister( pwr_t *pwr )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(pwr);
+
+	sys_lock();
+	{
+		priv_pwr_remove(pwr);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_lat_update( void )
+{
+	lat_t *lat;
+
+	BUDGET = INFINITE;
+	for (lat = LATENCY; lat; lat = lat->next)
+		if (BUDGET > lat->budget)
+			BUDGET = lat->budget;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_lat_remove( lat_t *lat )
+{
+	lat_t **ptr;
+
+	for (ptr = &LATENCY; *ptr; ptr = &(*ptr)->next)
+	{
+		if (*ptr == lat)
+		{
+			*ptr = lat->next;
+			break;
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+void pwr_require( lat_t *lat, cnt_t budget )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(lat);
+
+	sys_lock();
+	{
+		priv_lat_remove(lat);
+
+		lat->budget = budget;
+		lat->next = LATENCY;
+		LATENCY = lat;
+
+		priv_lat_update();
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void pwr_release( lat_t *lat )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(lat);
+
+	sys_lock();
+	{
+		priv_lat_remove(lat);
+		priv_lat_update();
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+cnt_t pwr_budget( void )
+/* -------------------------------------------------------------------------- */
+{
+	return BUDGET;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+pwr_t *priv_pwr_select( cnt_t delay )
+{
+	pwr_t *pwr;
+	pwr_t *sel = 0;
+
+	for (pwr = System.pwr; pwr && pwr->latency <= BUDGET; pwr = pwr->next)
+		if (pwr->residency <= delay)
+			sel = pwr;
+
+	return sel;
+}
+
+/* -------------------------------------------------------------------------- */
+pwr_t *pwr_select( cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	pwr_t *pwr;
+
+	sys_lock();
+	{
+		pwr = priv_pwr_select(delay);
+	}
+	sys_unlock();
+
+	return pwr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool core_pwr_idle( cnt_t delay )
+{
+	pwr_t *pwr = priv_pwr_select(delay);
+	cnt_t  cnt;
+
+	if (pwr == 0)
+		return false;
+
+	cnt = core_sys_time();
+#if HW_TIMER_SIZE == 0
+	System.cnt += pwr->enter(delay);
+#else
+	pwr->enter(delay);
+#endif
+	if (pwr->leave)
+		pwr->leave();
+
+	pwr->count++;
+	pwr->time += core_sys_time() - cnt;
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
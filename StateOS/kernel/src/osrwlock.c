@@ -0,0 +1,334 @@
+/******************************************************************************
+
+    @file    StateOS: osrwlock.c
+    @author  Rajmund Szymanski
+    @date    31.07.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/osrwlock.h"
+#include "inc/ostask.h"
+#include "inc/oscriticalsection.h"
+
+/* -------------------------------------------------------------------------- */
+void rwl_init( rwl_t *rwl, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(rwl);
+
+	sys_lock();
+	{
+		memset(rwl, 0, sizeof(rwl_t));
+
+		rwl->mode = mode;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+rwl_t *rwl_create( unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	rwl_t *rwl;
+
+	assert(!port_isr_inside());
+
+	sys_lock();
+	{
+		rwl = core_sys_alloc(sizeof(rwl_t));
+		rwl_init(rwl, mode);
+		rwl->res = rwl;
+	}
+	sys_unlock();
+
+	return rwl;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_rwl_link( rwl_t *rwl, tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	rwl->owner = tsk;
+
+	if (tsk)
+	{
+		rwl->list = tsk->rwl;
+		tsk->rwl = rwl;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_rwl_unlink( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk;
+	rwl_t *lst;
+
+	if (rwl->owner)
+	{
+		tsk = rwl->owner;
+
+		if (tsk->rwl == rwl)
+			tsk->rwl = rwl->list;
+
+		for (lst = tsk->rwl; lst; lst = lst->list)
+			if (lst->list == rwl)
+				lst->list = rwl->list;
+
+		rwl->list  = 0;
+		rwl->owner = 0;
+
+		core_tsk_prio(tsk, tsk->basic);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+void rwl_kill( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(rwl);
+
+	sys_lock();
+	{
+		priv_rwl_unlink(rwl);
+		rwl->count = 0;
+
+		core_all_wakeup(rwl, E_STOPPED);
+		core_all_wakeup(&rwl->write, E_STOPPED);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void rwl_delete( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	sys_lock();
+	{
+		rwl_kill(rwl);
+		core_sys_free(rwl->res);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_rwl_inherit( rwl_t *rwl, unsigned prio )
+/* -------------------------------------------------------------------------- */
+{
+	if (rwl->owner && rwl->owner->prio < prio)
+		core_tsk_prio(rwl->owner, prio);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_rwl_readers( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	while (core_one_wakeup(rwl, E_SUCCESS))
+		rwl->count++;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_rwl_writer( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	priv_rwl_link(rwl, core_one_wakeup(&rwl->write, E_SUCCESS));
+
+	// the new owner inherits the priority of the first of the remaining waiting tasks
+	if (rwl->queue) priv_rwl_inherit(rwl, rwl->queue->prio);
+	if (rwl->write) priv_rwl_inherit(rwl, rwl->write->prio);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_rwl_release( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	// the read-write lock object is free, hand it over to the waiting tasks
+	if (rwl->write && (rwl->mode == rwlPreferWriter || rwl->queue == 0))
+		priv_rwl_writer(rwl);
+	else
+		priv_rwl_readers(rwl);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_rwl_waitRead( rwl_t *rwl, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(rwl);
+
+	sys_lock();
+	{
+		if (rwl->owner == 0 && (rwl->mode == rwlPreferReader || rwl->write == 0))
+		{
+			if (rwl->count < ~0U)
+			{
+				rwl->count++;
+				event = E_SUCCESS;
+			}
+		}
+		else
+		{
+			priv_rwl_inherit(rwl, System.cur->prio);
+			event = wait(rwl, time); // the lock is handed over by the releasing task
+
+			// the owner may have inherited the priority of the task that has gone
+			if (event != E_SUCCESS && rwl->owner)
+				core_tsk_prio(rwl->owner, rwl->owner->basic);
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rwl_waitReadFor( rwl_t *rwl, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_rwl_waitRead(rwl, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rwl_waitReadUntil( rwl_t *rwl, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_rwl_waitRead(rwl, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rwl_giveRead( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(rwl);
+
+	sys_lock();
+	{
+		if (rwl->count)
+		{
+			if (--rwl->count == 0)
+				priv_rwl_release(rwl);
+
+			event = E_SUCCESS;
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_rwl_waitWrite( rwl_t *rwl, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(rwl);
+
+	sys_lock();
+	{
+		if (rwl->owner == 0 && rwl->count == 0)
+		{
+			priv_rwl_link(rwl, System.cur);
+			event = E_SUCCESS;
+		}
+		else
+		if (rwl->owner != System.cur)
+		{
+			priv_rwl_inherit(rwl, System.cur->prio);
+			event = wait(&rwl->write, time); // the lock is handed over by the releasing task
+
+			if (event != E_SUCCESS)
+			{
+				// the owner may have inherited the priority of the task that has gone
+				if (rwl->owner)
+					core_tsk_prio(rwl->owner, rwl->owner->basic);
+				else
+				// the last waiting writer has gone, release readers blocked by the writer preference
+				if (rwl->write == 0)
+					priv_rwl_readers(rwl);
+			}
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rwl_waitWriteFor( rwl_t *rwl, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_rwl_waitWrite(rwl, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rwl_waitWriteUntil( rwl_t *rwl, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_rwl_waitWrite(rwl, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned rwl_giveWrite( rwl_t *rwl )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(rwl);
+
+	sys_lock();
+	{
+		if (rwl->owner == System.cur)
+		{
+			priv_rwl_unlink(rwl);
+			priv_rwl_release(rwl);
+
+			event = E_SUCCESS;
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
@@ -30,6 +30,7 @@
  ******************************************************************************/
 
 #include "inc/ossemaphore.h"
+#include "inc/ostask.h"
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
@@ -69,6 +70,22 @@ sem_t *sem_create( unsigned init, unsigned limit )
 	return sem;
 }
 
+/* -------------------------------------------------------------------------- */
+void sem_setMode( sem_t *sem, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(sem);
+
+	sys_lock();
+	{
+		assert(sem->queue == 0);
+
+		sem->mode = mode;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void sem_kill( sem_t *sem )
 /* -------------------------------------------------------------------------- */
@@ -97,6 +114,46 @@ void sem_delete( sem_t *sem )
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+#ifdef OS_EXCLUSIVE
+/* -------------------------------------------------------------------------- */
+static
+bool priv_sem_takeFast( sem_t *sem )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned count;
+
+	do
+	{
+		count = port_ldrex(&sem->count);
+		if (count == 0 || sem->queue) // empty or any task waiting: use the kernel lock
+			return false;
+	}
+	while (!port_strex(&sem->count, count - 1));
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+bool priv_sem_giveFast( sem_t *sem )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned count;
+
+	do
+	{
+		count = port_ldrex(&sem->count);
+		if (count >= sem->limit || sem->queue) // full or any task waiting: use the kernel lock
+			return false;
+	}
+	while (!port_strex(&sem->count, count + 1));
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+#endif//OS_EXCLUSIVE
 /* -------------------------------------------------------------------------- */
 unsigned sem_take( sem_t *sem )
 /* -------------------------------------------------------------------------- */
@@ -106,6 +163,10 @@ unsigned sem_take( sem_t *sem )
 	assert(sem);
 	assert(sem->limit);
 
+#ifdef OS_EXCLUSIVE
+	if (priv_sem_takeFast(sem))
+		return E_SUCCESS;
+#endif
 	sys_lock();
 	{
 		if (sem->count > 0)
@@ -120,6 +181,36 @@ unsigned sem_take( sem_t *sem )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned sem_takeN( sem_t *sem, unsigned num )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt = 0;
+	unsigned rem;
+
+	assert(sem);
+	assert(sem->limit);
+
+	sys_lock();
+	{
+		// the semaphore is full: each taken unit is replaced by the unit of a waiting task
+		while (cnt < num && sem->count > 0 && core_one_wakeup(sem, E_SUCCESS))
+			cnt++;
+
+		if (cnt < num && sem->count > 0)
+		{
+			rem = num - cnt;
+			if (rem > sem->count)
+				rem = sem->count;
+			sem->count -= rem;
+			cnt += rem;
+		}
+	}
+	sys_unlock();
+
+	return cnt;
+}
+
 /* -------------------------------------------------------------------------- */
 static
 unsigned priv_sem_wait( sem_t *sem, cnt_t time, unsigned(*wait)(void*,cnt_t) )
@@ -131,6 +222,10 @@ unsigned priv_sem_wait( sem_t *sem, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 	assert(sem);
 	assert(sem->limit);
 
+#ifdef OS_EXCLUSIVE
+	if (priv_sem_takeFast(sem))
+		return E_SUCCESS;
+#endif
 	sys_lock();
 	{
 		if (sem->count > 0)
@@ -141,6 +236,7 @@ unsigned priv_sem_wait( sem_t *sem, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 		}
 		else
 		{
+			System.cur->fifo = sem->mode == semFifo;
 			event = wait(sem, time);
 		}
 	}
@@ -172,6 +268,10 @@ unsigned sem_give( sem_t *sem )
 	assert(sem);
 	assert(sem->limit);
 
+#ifdef OS_EXCLUSIVE
+	if (priv_sem_giveFast(sem))
+		return E_SUCCESS;
+#endif
 	sys_lock();
 	{
 		if (sem->count < sem->limit)
@@ -186,6 +286,36 @@ unsigned sem_give( sem_t *sem )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned sem_giveN( sem_t *sem, unsigned num )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt = 0;
+	unsigned rem;
+
+	assert(sem);
+	assert(sem->limit);
+
+	sys_lock();
+	{
+		// the semaphore is empty: waiting tasks are resumed first
+		while (cnt < num && sem->count < sem->limit && core_one_wakeup(sem, E_SUCCESS))
+			cnt++;
+
+		if (cnt < num && sem->count < sem->limit)
+		{
+			rem = num - cnt;
+			if (rem > sem->limit - sem->count)
+				rem = sem->limit - sem->count;
+			sem->count += rem;
+			cnt += rem;
+		}
+	}
+	sys_unlock();
+
+	return cnt;
+}
+
 /* -------------------------------------------------------------------------- */
 static
 unsigned priv_sem_send( sem_t *sem, cnt_t time, unsigned(*wait)(void*,cnt_t) )
@@ -197,6 +327,10 @@ unsigned priv_sem_send( sem_t *sem, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 	assert(sem);
 	assert(sem->limit);
 
+#ifdef OS_EXCLUSIVE
+	if (priv_sem_giveFast(sem))
+		return E_SUCCESS;
+#endif
 	sys_lock();
 	{
 		if (sem->count < sem->limit)
@@ -207,6 +341,7 @@ unsigned priv_sem_send( sem_t *sem, cnt_t time, unsigned(*wait)(void*,cnt_t) )
 		}
 		else
 		{
+			System.cur->fifo = sem->mode == semFifo;
 			event = wait(sem, time);
 		}
 	}
@@ -0,0 +1,65 @@
+/******************************************************************************
+
+    @file    StateOS: osseqlock.c
+    @author  Rajmund Szymanski
+    @date    31.07.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/osseqlock.h"
+
+/* -------------------------------------------------------------------------- */
+void seq_write( seq_t *seq, void *data, const void *src, size_t size )
+/* -------------------------------------------------------------------------- */
+{
+	assert(seq);
+	assert(data);
+	assert(src);
+
+	seq_writeBegin(seq);
+	memcpy(data, src, size);
+	seq_writeEnd(seq);
+}
+
+/* -------------------------------------------------------------------------- */
+void seq_read( seq_t *seq, const void *data, void *dst, size_t size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned num;
+
+	assert(seq);
+	assert(data);
+	assert(dst);
+
+	do
+	{
+		num = seq_readBegin(seq);
+		memcpy(dst, data, size);
+	}
+	while (seq_readRetry(seq, num));
+}
+
+/* -------------------------------------------------------------------------- */
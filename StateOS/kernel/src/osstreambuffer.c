@@ -40,6 +40,7 @@ void stm_init( stm_t *stm, unsigned limit, void *data )
 	assert(!port_isr_inside());
 	assert(stm);
 	assert(limit);
+	assert(POW2LIMIT(limit));
 	assert(data);
 
 	sys_lock();
@@ -48,6 +49,7 @@ void stm_init( stm_t *stm, unsigned limit, void *data )
 
 		stm->limit = limit;
 		stm->data  = data;
+		stm->mask  = POW2MASK(limit);
 	}
 	sys_unlock();
 }
@@ -72,6 +74,26 @@ stm_t *stm_create( unsigned limit )
 	return stm;
 }
 
+/* -------------------------------------------------------------------------- */
+void stm_setMode( stm_t *stm, unsigned mode )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(stm);
+	assert(mode != stmSPSC || stm->mask);
+
+	sys_lock();
+	{
+		assert(stm->queue == 0 && stm->read == 0);
+
+		if (stm->mode == stmSPSC)
+			stm->count = stm->tail - stm->head; // the counter is not updated in the stmSPSC mode
+
+		stm->mode = mode;
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void stm_kill( stm_t *stm )
 /* -------------------------------------------------------------------------- */
@@ -86,6 +108,7 @@ void stm_kill( stm_t *stm )
 		stm->tail  = 0;
 
 		core_all_wakeup(stm, E_STOPPED);
+		core_all_wakeup(&stm->read, E_STOPPED);
 	}
 	sys_unlock();
 }
@@ -107,7 +130,8 @@ static
 unsigned priv_stm_count( stm_t *stm )
 /* -------------------------------------------------------------------------- */
 {
-	return stm->count;
+	// in the stmSPSC mode the counter is not updated
+	return stm->mode == stmSPSC ? stm->tail - stm->head : stm->count;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -115,8 +139,10 @@ static
 unsigned priv_stm_space( stm_t *stm )
 /* -------------------------------------------------------------------------- */
 {
-	return (stm->count == 0) ? stm->limit :
-	       (stm->queue == 0) ? stm->limit - stm->count :
+	unsigned cnt = priv_stm_count(stm);
+
+	return (cnt == 0)        ? stm->limit :
+	       (stm->queue == 0) ? stm->limit - cnt :
 	                           0;
 }
 
@@ -126,8 +152,7 @@ void priv_stm_skip( stm_t *stm, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
 	stm->count -= size;
-	stm->head  += size;
-	if (stm->head >= stm->limit) stm->head -= stm->limit;
+	stm->head = POW2INDEX(stm) ? stm->head + size : core_buf_add(stm->limit, stm->head, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -135,15 +160,11 @@ static
 void priv_stm_get( stm_t *stm, char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = stm->head;
-
-	stm->count -= size;;
-	while (size--)
-	{
-		*data++ = stm->data[i++];
-		if (i >= stm->limit) i = 0;
-	}
-	stm->head = i;
+	stm->count -= size;
+	if (POW2INDEX(stm))
+		stm->head = core_pow2_get(stm->data, stm->mask, stm->head, data, size);
+	else
+		stm->head = core_buf_get(stm->data, stm->limit, stm->head, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -151,26 +172,39 @@ static
 void priv_stm_put( stm_t *stm, const char *data, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	unsigned i = stm->tail;
-
 	stm->count += size;
-	while (size--)
-	{
-		stm->data[i++] = *data++;
-		if (i >= stm->limit) i = 0;
-	}
-	stm->tail = i;
+	if (POW2INDEX(stm))
+		stm->tail = core_pow2_put(stm->data, stm->mask, stm->tail, data, size);
+	else
+		stm->tail = core_buf_put(stm->data, stm->limit, stm->tail, data, size);
 }
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
+void priv_stm_span( stm_t *stm, stm_span_t *span, unsigned idx, unsigned size )
 /* -------------------------------------------------------------------------- */
 {
-	priv_stm_get(stm, data, size);
+	unsigned pos = POW2INDEX(stm) ? idx & stm->mask : idx;
+
+	span[0].data = stm->data + pos;
+	span[0].size = (size < stm->limit - pos) ? size : stm->limit - pos;
+	span[1].data = stm->data;
+	span[1].size = size - span[0].size;
+}
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_putQueue( stm_t *stm )
+/* -------------------------------------------------------------------------- */
+{
 	while (stm->queue != 0 && stm->queue->tmp.stm.size <= stm->limit - stm->count)
 	{
+		if (stm->queue->tmp.stm.data.out == 0) // the task is waiting for the free space to reserve
+		{
+			core_tsk_wakeup(stm->queue, E_SUCCESS);
+			break;
+		}
+
 		priv_stm_put(stm, stm->queue->tmp.stm.data.out, stm->queue->tmp.stm.size);
 		core_tsk_wakeup(stm->queue, E_SUCCESS);
 	}
@@ -178,16 +212,15 @@ void priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+void priv_stm_getQueue( stm_t *stm )
 /* -------------------------------------------------------------------------- */
 {
-	priv_stm_put(stm, data, size);
-
 	while (stm->queue != 0 && stm->count > 0)
 	{
 		if (stm->queue->tmp.stm.size <= stm->count)
 		{
-			priv_stm_get(stm, stm->queue->tmp.stm.data.in, stm->queue->tmp.stm.size);
+			if (stm->queue->tmp.stm.data.in != 0) // otherwise the task is waiting for the data to peek
+				priv_stm_get(stm, stm->queue->tmp.stm.data.in, stm->queue->tmp.stm.size);
 			core_tsk_wakeup(stm->queue, E_SUCCESS);
 		}
 		else
@@ -197,6 +230,57 @@ void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
 	}
 }
 
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_trigger( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned lvl = stm->trigger ? stm->trigger : 1;
+
+	return (size < lvl) ? size : lvl;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_readQueue( stm_t *stm, bool all )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned size;
+
+	// tasks waiting for any amount of data are woken when the trigger level is reached
+	// or unconditionally ('all') when a writer would have to wait for the free space
+	while (stm->read != 0 && stm->count > 0)
+	{
+		size = stm->read->tmp.stm.size;
+		if (!all && stm->count < priv_stm_trigger(stm, size))
+			break;
+		if (size > stm->count)
+			size = stm->count;
+		priv_stm_get(stm, stm->read->tmp.stm.data.in, size);
+		stm->read->tmp.stm.size -= size;
+		core_tsk_wakeup(stm->read, E_SUCCESS);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	priv_stm_get(stm, data, size);
+	priv_stm_putQueue(stm);
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	priv_stm_put(stm, data, size);
+	priv_stm_getQueue(stm);
+	priv_stm_readQueue(stm, false);
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_take( stm_t *stm, void *data, unsigned size )
 /* -------------------------------------------------------------------------- */
@@ -204,6 +288,7 @@ unsigned stm_take( stm_t *stm, void *data, unsigned size )
 	unsigned event = E_TIMEOUT;
 
 	assert(stm);
+	assert(stm->mode != stmSPSC);
 	assert(data);
 
 	sys_lock();
@@ -228,6 +313,7 @@ unsigned priv_stm_wait( stm_t *stm, char *data, unsigned size, cnt_t time, unsig
 
 	assert(!port_isr_inside());
 	assert(stm);
+	assert(stm->mode != stmSPSC);
 	assert(data);
 
 	sys_lock();
@@ -270,6 +356,94 @@ unsigned stm_waitUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
 	return priv_stm_wait(stm, data, size, time, core_tsk_waitUntil);
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned stm_tryRead( stm_t *stm, void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len;
+
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(data);
+
+	sys_lock();
+	{
+		len = (size < stm->count) ? size : stm->count;
+		if (len > 0)
+			priv_stm_getUpdate(stm, data, len);
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_read( stm_t *stm, char *data, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned len = 0;
+
+	assert(!port_isr_inside());
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(data);
+
+	sys_lock();
+	{
+		if (size > 0)
+		{
+			if (stm->count == 0)
+			{
+				System.cur->tmp.stm.data.in = data;
+				System.cur->tmp.stm.size = size;
+				if (wait(&stm->read, time) == E_SUCCESS)
+					len = size - System.cur->tmp.stm.size;
+			}
+
+			// the data is available or has not reached the trigger level before the timeout
+			if (len == 0 && stm->count > 0)
+			{
+				len = (size < stm->count) ? size : stm->count;
+				priv_stm_getUpdate(stm, data, len);
+			}
+		}
+	}
+	sys_unlock();
+
+	return len;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_readFor( stm_t *stm, void *data, unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_read(stm, data, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_readUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_read(stm, data, size, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+void stm_setTrigger( stm_t *stm, unsigned trigger )
+/* -------------------------------------------------------------------------- */
+{
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(trigger <= stm->limit);
+
+	sys_lock();
+	{
+		stm->trigger = trigger;
+		priv_stm_readQueue(stm, false);
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_give( stm_t *stm, const void *data, unsigned size )
 /* -------------------------------------------------------------------------- */
@@ -277,10 +451,14 @@ unsigned stm_give( stm_t *stm, const void *data, unsigned size )
 	unsigned event = E_TIMEOUT;
 
 	assert(stm);
+	assert(stm->mode != stmSPSC);
 	assert(data);
 
 	sys_lock();
 	{
+		if (size > priv_stm_space(stm))
+			priv_stm_readQueue(stm, true);
+
 		if (size > 0 && size <= priv_stm_space(stm))
 		{
 			priv_stm_putUpdate(stm, data, size);
@@ -301,12 +479,16 @@ unsigned priv_stm_send( stm_t *stm, const char *data, unsigned size, cnt_t time,
 
 	assert(!port_isr_inside());
 	assert(stm);
+	assert(stm->mode != stmSPSC);
 	assert(data);
 
 	sys_lock();
 	{
 		if (size > 0)
 		{
+			if (size > priv_stm_space(stm))
+				priv_stm_readQueue(stm, true);
+
 			if (size <= priv_stm_space(stm))
 			{
 				priv_stm_putUpdate(stm, data, size);
@@ -347,6 +529,7 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size )
 	unsigned event = E_TIMEOUT;
 
 	assert(stm);
+	assert(stm->mode != stmSPSC);
 	assert(data);
 
 	sys_lock();
@@ -367,6 +550,392 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size )
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned stm_reserve( stm_t *stm, stm_span_t span[2] )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(span);
+
+	sys_lock();
+	{
+		cnt = stm->limit - stm->count;
+		priv_stm_span(stm, span, stm->tail, cnt);
+	}
+	sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_reserve( stm_t *stm, stm_span_t *span, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(span);
+
+	sys_lock();
+	{
+		if (size > 0 && size <= stm->limit)
+		{
+			if (size > stm->limit - stm->count)
+				priv_stm_readQueue(stm, true);
+
+			if (size <= stm->limit - stm->count)
+			{
+				event = E_SUCCESS;
+			}
+			else
+			{
+				System.cur->tmp.stm.data.out = 0;
+				System.cur->tmp.stm.size = size;
+				event = wait(stm, time);
+			}
+
+			if (event == E_SUCCESS)
+				priv_stm_span(stm, span, stm->tail, stm->limit - stm->count);
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_reserveFor( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_reserve(stm, span, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_reserveUntil( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_reserve(stm, span, size, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_commit( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+
+	sys_lock();
+	{
+		if (size <= stm->limit - stm->count)
+		{
+			// tasks waiting for the data are in the queue only when the stream buffer is empty
+			bool empty = stm->count == 0;
+
+			stm->count += size;
+			stm->tail = POW2INDEX(stm) ? stm->tail + size : core_buf_add(stm->limit, stm->tail, size);
+
+			if (empty)
+				priv_stm_getQueue(stm);
+			priv_stm_readQueue(stm, false);
+
+			event = E_SUCCESS;
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_peek( stm_t *stm, stm_span_t span[2] )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(span);
+
+	sys_lock();
+	{
+		cnt = stm->count;
+		priv_stm_span(stm, span, stm->head, cnt);
+	}
+	sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_peek( stm_t *stm, stm_span_t *span, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(!port_isr_inside());
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+	assert(span);
+
+	sys_lock();
+	{
+		if (size > 0)
+		{
+			if (stm->count > 0)
+			{
+				if (size <= stm->count)
+					event = E_SUCCESS;
+			}
+			else
+			if (size <= stm->limit)
+			{
+				System.cur->tmp.stm.data.in = 0;
+				System.cur->tmp.stm.size = size;
+				event = wait(stm, time);
+			}
+
+			if (event == E_SUCCESS)
+				priv_stm_span(stm, span, stm->head, stm->count);
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_peekFor( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_peek(stm, span, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_peekUntil( stm_t *stm, stm_span_t span[2], unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_peek(stm, span, size, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_consume( stm_t *stm, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+
+	assert(stm);
+	assert(stm->mode != stmSPSC);
+
+	sys_lock();
+	{
+		if (size <= stm->count)
+		{
+			if (size > 0)
+			{
+				priv_stm_skip(stm, size);
+				priv_stm_putQueue(stm);
+			}
+			event = E_SUCCESS;
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+// single-producer/single-consumer functions, only for the stream buffer object in the stmSPSC mode
+// the capacity is a power of two, the head index is written only by the consumer and the tail index only by the producer;
+// the counter is not updated, the amount of data is (tail - head) and the data is transfered without the kernel lock;
+// the lock is taken only when the other side may wait in the queue (a full buffer for the producer, an empty one for the consumer)
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_takeSPSC( stm_t *stm, void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+	unsigned head;
+
+	assert(stm);
+	assert(stm->mode == stmSPSC);
+	assert(data);
+
+	head = stm->head;
+
+	if (size > 0 && size <= stm->tail - head)
+	{
+		port_mem_barrier(); // read the data after the tail index
+		head = core_pow2_get(stm->data, stm->mask, head, data, size);
+		port_mem_barrier(); // release the space after the data has been read
+		stm->head = head;
+		port_mem_barrier(); // check the queue after the head index has been updated
+
+		// only the producer can wait in the queue
+		if (stm->queue != 0)
+		{
+			sys_lock();
+			{
+				if (stm->queue != 0 && stm->queue->tmp.stm.size <= stm->limit - (stm->tail - stm->head))
+					core_tsk_wakeup(stm->queue, E_SUCCESS);
+			}
+			sys_unlock();
+		}
+
+		event = E_SUCCESS;
+	}
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_waitSPSC( stm_t *stm, char *data, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(!port_isr_inside());
+
+	event = stm_takeSPSC(stm, data, size);
+
+	if (event != E_SUCCESS && size > 0 && size <= stm->limit)
+	{
+		sys_lock();
+		{
+			// as in the stm_wait function, the consumer waits only when the stream buffer is empty;
+			// so the producer and the consumer never wait in the queue at the same time
+			if (stm->tail == stm->head)
+			{
+				System.cur->tmp.stm.data.in = data;
+				System.cur->tmp.stm.size = size;
+				event = wait(stm, time);
+			}
+			else
+			{
+				event = E_SUCCESS;
+			}
+		}
+		sys_unlock();
+
+		// the producer has woken the task when the data became available
+		if (event == E_SUCCESS)
+			event = stm_takeSPSC(stm, data, size);
+	}
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_waitSPSCFor( stm_t *stm, void *data, unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_waitSPSC(stm, data, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_waitSPSCUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_waitSPSC(stm, data, size, time, core_tsk_waitUntil);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_giveSPSC( stm_t *stm, const void *data, unsigned size )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_TIMEOUT;
+	unsigned tail;
+
+	assert(stm);
+	assert(stm->mode == stmSPSC);
+	assert(data);
+
+	tail = stm->tail;
+
+	if (size > 0 && size <= stm->limit - (tail - stm->head))
+	{
+		port_mem_barrier(); // write the data after the head index
+		tail = core_pow2_put(stm->data, stm->mask, tail, data, size);
+		port_mem_barrier(); // publish the data after it has been written
+		stm->tail = tail;
+		port_mem_barrier(); // check the queue after the tail index has been updated
+
+		// only the consumer can wait in the queue, it is woken as in the stm_give function
+		if (stm->queue != 0)
+		{
+			sys_lock();
+			{
+				if (stm->queue != 0)
+					core_tsk_wakeup(stm->queue, stm->queue->tmp.stm.size <= stm->tail - stm->head ? E_SUCCESS : E_TIMEOUT);
+			}
+			sys_unlock();
+		}
+
+		event = E_SUCCESS;
+	}
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_stm_sendSPSC( stm_t *stm, const char *data, unsigned size, cnt_t time, unsigned(*wait)(void*,cnt_t) )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event;
+
+	assert(!port_isr_inside());
+
+	event = stm_giveSPSC(stm, data, size);
+
+	if (event != E_SUCCESS && size > 0 && size <= stm->limit)
+	{
+		sys_lock();
+		{
+			if (size > stm->limit - (stm->tail - stm->head))
+			{
+				System.cur->tmp.stm.data.out = data;
+				System.cur->tmp.stm.size = size;
+				event = wait(stm, time);
+			}
+			else
+			{
+				event = E_SUCCESS;
+			}
+		}
+		sys_unlock();
+
+		// the consumer has woken the task when the space became available
+		if (event == E_SUCCESS)
+			event = stm_giveSPSC(stm, data, size);
+	}
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_sendSPSCFor( stm_t *stm, const void *data, unsigned size, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_sendSPSC(stm, data, size, delay, core_tsk_waitFor);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned stm_sendSPSCUntil( stm_t *stm, const void *data, unsigned size, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	return priv_stm_sendSPSC(stm, data, size, time, core_tsk_waitUntil);
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned stm_count( stm_t *stm )
 /* -------------------------------------------------------------------------- */
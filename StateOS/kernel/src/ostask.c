@@ -30,11 +30,19 @@
  ******************************************************************************/
 
 #include "inc/ostask.h"
+#include "inc/osrwlock.h"
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
 void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned size )
 /* -------------------------------------------------------------------------- */
+{
+	tsk_initThreshold(tsk, prio, state, stack, size, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+void tsk_initThreshold( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned size, unsigned thresh )
+/* -------------------------------------------------------------------------- */
 {
 	assert(!port_isr_inside());
 	assert(tsk);
@@ -46,8 +54,10 @@ void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned si
 	{
 		memset(tsk, 0, sizeof(tsk_t));
 
-		tsk->prio  = prio;
-		tsk->basic = prio;
+		tsk->prio  = core_prio_limit(prio);
+		tsk->basic = tsk->prio;
+		tsk->thresh = core_prio_limit(thresh);
+		tsk->quantum = _TSK_SLICE;
 		tsk->state = state;
 		tsk->stack = stack;
 		tsk->top   = (stk_t *) LIMITED((char *)stack + size, stk_t);
@@ -61,6 +71,13 @@ void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, void *stack, unsigned si
 /* -------------------------------------------------------------------------- */
 tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size )
 /* -------------------------------------------------------------------------- */
+{
+	return wrk_createThreshold(prio, state, size, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+tsk_t *wrk_createThreshold( unsigned prio, fun_t *state, unsigned size, unsigned thresh )
+/* -------------------------------------------------------------------------- */
 {
 	tsk_t *tsk;
 
@@ -72,7 +89,7 @@ tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size )
 	{
 		size = ABOVE(size);
 		tsk = core_sys_alloc(ABOVE(sizeof(tsk_t)) + size);
-		tsk_init(tsk, prio, state, (void *)((size_t)tsk + ABOVE(sizeof(tsk_t))), size);
+		tsk_initThreshold(tsk, prio, state, (void *)((size_t)tsk + ABOVE(sizeof(tsk_t))), size, thresh);
 		tsk->obj.res = tsk;
 	}
 	sys_unlock();
@@ -92,6 +109,8 @@ void tsk_start( tsk_t *tsk )
 	{
 		if (tsk->id == ID_STOPPED)
 		{
+			tsk->basic = tsk->prio = core_prio_limit(tsk->basic); // statically defined task
+
 			core_ctx_init(tsk);
 			core_tsk_insert(tsk);
 		}
@@ -112,6 +131,7 @@ void tsk_startFrom( tsk_t *tsk, fun_t *state )
 		if (tsk->id == ID_STOPPED)
 		{
 			tsk->state = state;
+			tsk->basic = tsk->prio = core_prio_limit(tsk->basic); // statically defined task
 
 			core_ctx_init(tsk);
 			core_tsk_insert(tsk);
@@ -126,6 +146,7 @@ void tsk_stop( void )
 {
 	assert(!port_isr_inside());
 	assert(!System.cur->mtx.list);
+	assert(!System.cur->rwl);
 
 	port_set_lock();
 
@@ -153,6 +174,8 @@ void tsk_kill( tsk_t *tsk )
 			tsk->mtx.tree = 0;
 			while (tsk->mtx.list)
 				mtx_kill(tsk->mtx.list);
+			while (tsk->rwl)
+				rwl_kill(tsk->rwl);
 
 			if (tsk->join != DETACHED)
 				core_tsk_wakeup(tsk->join, E_STOPPED);
@@ -272,12 +295,41 @@ void tsk_prio( unsigned prio )
 
 	sys_lock();
 	{
+		prio = core_prio_limit(prio);
 		System.cur->basic = prio;
 		core_cur_prio(prio);
 	}
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+void tsk_setSlice( tsk_t *tsk, cnt_t quantum )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(tsk);
+
+	sys_lock();
+	{
+		tsk->quantum = quantum;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void tsk_setThreshold( tsk_t *tsk, unsigned thresh )
+/* -------------------------------------------------------------------------- */
+{
+	assert(!port_isr_inside());
+	assert(tsk);
+
+	sys_lock();
+	{
+		core_tsk_thresh(tsk, core_prio_limit(thresh));
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 static
 unsigned priv_tsk_wait( unsigned flags, cnt_t time, unsigned(*wait)(void*,cnt_t) )
@@ -329,6 +381,28 @@ void tsk_give( tsk_t *tsk, unsigned flags )
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+unsigned tsk_sleepForSlack( cnt_t delay, cnt_t slack )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * cur = System.cur;
+	unsigned event;
+
+	assert(!port_isr_inside());
+
+	sys_lock();
+	{
+		cur->start = core_sys_time();
+		cur->delay = delay;
+
+		core_tmr_align((tmr_t *)cur, slack);
+		event = core_tsk_waitNext(&WAIT, cur->delay);
+	}
+	sys_unlock();
+
+	return event;
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned tsk_suspend( tsk_t *tsk )
 /* -------------------------------------------------------------------------- */
@@ -126,6 +126,27 @@ void tmr_start( tmr_t *tmr, cnt_t delay, cnt_t period )
 	sys_unlock();
 }
 
+/* -------------------------------------------------------------------------- */
+void tmr_startSlack( tmr_t *tmr, cnt_t delay, cnt_t period, cnt_t slack )
+/* -------------------------------------------------------------------------- */
+{
+	assert(tmr);
+
+	sys_lock();
+	{
+		if (tmr->id != ID_STOPPED)
+			core_tmr_remove(tmr);
+
+		tmr->start  = core_sys_time();
+		tmr->delay  = delay;
+		tmr->period = period;
+
+		core_tmr_align(tmr, slack);
+		priv_tmr_start(tmr);
+	}
+	sys_unlock();
+}
+
 /* -------------------------------------------------------------------------- */
 void tmr_startFrom( tmr_t *tmr, cnt_t delay, cnt_t period, fun_t *proc )
 /* -------------------------------------------------------------------------- */
@@ -56,6 +56,19 @@
 #include <stdio.h>
 #include <osnasa.h>
 
+/* -------------------------------------------------------------------------- */
+/*
+** OSAL priority (1 - the highest, 255 - the lowest) to StateOS priority conversion
+*/
+
+#if     OS_PRIO_LEVELS == 0
+#define OSAL_PRIO( prio )      (~(prio))
+#elif   OS_PRIO_LEVELS >= 256
+#define OSAL_PRIO( prio )      ((OS_PRIO_LEVELS)-(prio))
+#else
+#error  osconfig.h: NASA OSAL requires OS_PRIO_LEVELS == 0 or OS_PRIO_LEVELS >= 256
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*
 ** OSAL internal data
@@ -818,7 +831,7 @@ int32 OS_MutSemCreate(uint32 *semaphore_id, const char *sem_name, uint32 options
 				else
 				{
 					*semaphore_id = rec - OS_mut_sem_table;
-					mtx_init(&rec->mtx);
+					mtx_init(&rec->mtx, mtxPrioInherit, 0);
 					strcpy(rec->name, sem_name);
 					rec->creator = OS_TaskGetId();
 					rec->used = 1;
@@ -1017,7 +1030,7 @@ int32 OS_TaskCreate(uint32 *task_id, const char *task_name, osal_task_entry func
 					else
 					{
 						*task_id = rec - OS_task_table;
-						tsk_init(&rec->tsk, ~priority, task_handler, stack, stack_size);
+						tsk_init(&rec->tsk, OSAL_PRIO(priority), task_handler, stack, stack_size);
 						if (stack_pointer == 0) rec->tsk.obj.res = stack;
 						strcpy(rec->name, task_name);
 						rec->creator = OS_TaskGetId();
@@ -1112,7 +1125,7 @@ int32 OS_TaskSetPriority(uint32 task_id, uint32 new_priority)
 			status = OS_ERR_INVALID_PRIORITY;
 		else
 		{
-			core_tsk_prio(&rec->tsk, rec->tsk.basic = ~new_priority);
+			core_tsk_prio(&rec->tsk, rec->tsk.basic = OSAL_PRIO(new_priority));
 			status =  OS_SUCCESS;
 		}
 	}
@@ -1186,7 +1199,7 @@ int32 OS_TaskGetInfo(uint32 task_id, OS_task_prop_t *task_prop)
 			strcpy(task_prop->name, rec->name);
 			task_prop->creator = rec->creator;
 			task_prop->stack_size = (uint32_t) rec->tsk.top - (uint32_t) rec->tsk.stack;
-			task_prop->priority = ~rec->tsk.basic;
+			task_prop->priority = OSAL_PRIO(rec->tsk.basic);
 			task_prop->OStask_id = (uint32) &rec->tsk;
 			status = OS_SUCCESS;
 		}
@@ -72,6 +72,52 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#ifndef OS_PRIO_LEVELS
+#define OS_PRIO_LEVELS        0 /* number of task priority levels: unlimited  */
+#endif
+
+#if     OS_PRIO_LEVELS && OS_MAIN_PRIO >= OS_PRIO_LEVELS
+#error  osconfig.h: Incorrect OS_MAIN_PRIO value! Must be less then OS_PRIO_LEVELS.
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TIMER_WHEEL
+#define OS_TIMER_WHEEL        0 /* number of timing wheel levels: sorted list */
+#endif
+
+#ifndef OS_TIMER_BATCH
+#define OS_TIMER_BATCH        0 /* max number of expirations per lock: no limit */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_RING_POW2
+#define OS_RING_POW2          1 /* ring buffer index scheme: run-time choice  */
+#endif
+
+#if     OS_TIMER_TASK
+
+#ifndef OS_TIMER_PRIO
+#if     OS_PRIO_LEVELS
+#define OS_TIMER_PRIO ((OS_PRIO_LEVELS)-1) /* priority of timer service task */
+#else
+#define OS_TIMER_PRIO      (~0U) /* priority of timer service task            */
+#endif
+#endif
+
+#ifndef OS_TIMER_STACK
+#define OS_TIMER_STACK OS_STACK_SIZE /* timer service task stack size in bytes */
+#endif
+
+#if     OS_PRIO_LEVELS && OS_TIMER_PRIO >= OS_PRIO_LEVELS
+#error  osconfig.h: Incorrect OS_TIMER_PRIO value! Must be less then OS_PRIO_LEVELS.
+#endif
+
+#endif//OS_TIMER_TASK
+
+/* -------------------------------------------------------------------------- */
+
 #ifdef  __cplusplus
 
 #ifndef OS_FUNCTIONAL
@@ -139,6 +185,7 @@ void port_ctx_init( ctx_t *ctx, fun_t *pc )
 
 #define __get_BASEPRI()     __ASM("mrs r0,basepri")
 #define __set_BASEPRI(val)  __ASM("msr basepri,r0", val)
+#define __CLZ(val)          __ASM("clz r0,r0", val)
 
 #endif
 
@@ -203,6 +250,25 @@ void * port_get_sp( void )
 #endif
 
 #define port_set_barrier()  __ISB()
+#define port_mem_barrier()  __DMB()
+
+/* -------------------------------------------------------------------------- */
+// get index of the least significant bit set in the non-zero value
+
+__STATIC_INLINE
+unsigned port_lsb( uint32_t val )
+{
+	return 31U - __CLZ(val & (0U - val));
+}
+
+/* -------------------------------------------------------------------------- */
+// get index of the most significant bit set in the non-zero value
+
+__STATIC_INLINE
+unsigned port_msb( uint32_t val )
+{
+	return 31U - __CLZ(val);
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -228,6 +294,39 @@ void port_spn_lock( volatile unsigned *lock )
 
 /* -------------------------------------------------------------------------- */
 
+#if __CORTEX_M >= 3
+
+#ifdef  OS_EXCLUSIVE
+
+#error  OS_EXCLUSIVE is an internal port definition!
+
+#else
+
+#define OS_EXCLUSIVE
+
+// exclusive load of the word (LDREX); memory accesses that follow are not moved before it
+__STATIC_INLINE
+unsigned port_ldrex( volatile unsigned *addr )
+{
+	unsigned val = __LDREXW((volatile uint32_t *)addr);
+	__DMB();
+	return val;
+}
+
+// exclusive store of the word (STREX); return true if the word has not been touched since port_ldrex
+// (exclusive monitor is cleared by any exception, so any preemption makes the store fail)
+__STATIC_INLINE
+bool port_strex( volatile unsigned *addr, unsigned val )
+{
+	return __STREXW(val, (volatile uint32_t *)addr) == 0U;
+}
+
+#endif//OS_EXCLUSIVE
+
+#endif//__CORTEX_M
+
+/* -------------------------------------------------------------------------- */
+
 #ifdef __cplusplus
 }
 #endif
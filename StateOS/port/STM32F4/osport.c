@@ -164,6 +164,98 @@ void SysTick_Handler( void )
  End of the handler
 *******************************************************************************/
 
+	#if OS_TICKLESS
+
+/******************************************************************************
+ Non-tick-less mode with tick suppression: sleep across multiple ticks
+ SysTick is reloaded with the remaining part of the current tick and 'ticks'-1 whole ticks
+ The phase of the system timer is preserved on wakeup
+*******************************************************************************/
+
+	#if (CPU_FREQUENCY)/(OS_FREQUENCY)-1 <= SysTick_LOAD_RELOAD_Msk
+	#define ST_PERIOD ((CPU_FREQUENCY)/(OS_FREQUENCY))
+	#else
+	#define ST_PERIOD ((ST_FREQUENCY)/(OS_FREQUENCY))
+	#endif
+
+cnt_t port_tck_sleep( cnt_t ticks )
+{
+	uint32_t ctrl, load, cnt, rem;
+	cnt_t    elapsed;
+
+	if (ticks > (SysTick_LOAD_RELOAD_Msk+1UL)/(ST_PERIOD))
+		ticks = (SysTick_LOAD_RELOAD_Msk+1UL)/(ST_PERIOD);
+
+	if (ticks < 2)
+	{
+		__WFI();
+		return 0;
+	}
+
+	ctrl = SysTick->CTRL & ~SysTick_CTRL_COUNTFLAG_Msk;
+	SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) // the current tick has just ended
+	{
+		SysTick->CTRL = ctrl;
+		return 0;
+	}
+
+	cnt  = SysTick->VAL;
+	load = cnt + (uint32_t)(ticks - 1) * (ST_PERIOD);
+
+	SysTick->LOAD = load;
+	SysTick->VAL  = 0U;
+	SysTick->CTRL = ctrl;
+
+	__DSB();
+	__WFI();
+
+	SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) // the whole period has elapsed and the last tick will be signalled by the handler
+	{
+		rem = load - SysTick->VAL;
+		elapsed = (cnt_t)(ticks - 1) + rem / (ST_PERIOD);
+		rem = (ST_PERIOD) - rem % (ST_PERIOD);
+	}
+	else
+	{
+		rem = load - SysTick->VAL;
+		if (rem < cnt)
+		{
+			elapsed = 0;
+			rem = cnt - rem;
+		}
+		else
+		{
+			rem -= cnt;
+			elapsed = 1 + rem / (ST_PERIOD);
+			rem = (ST_PERIOD) - rem % (ST_PERIOD);
+		}
+	}
+
+	if (rem < 32) // too short to reload safely; merge with the next tick
+	{
+		elapsed++;
+		rem += (ST_PERIOD);
+	}
+
+	SysTick->LOAD = rem - 1;
+	SysTick->VAL  = 0U;
+	SysTick->CTRL = ctrl;
+	while (SysTick->VAL == 0U); // wait for the reload
+	SysTick->LOAD = (ST_PERIOD) - 1;
+
+	return elapsed;
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+	#endif//OS_TICKLESS
+
 #else //HW_TIMER_SIZE
 
 /******************************************************************************
@@ -228,7 +320,7 @@ cnt_t port_sys_time( void )
 void SysTick_Handler( void )
 {
 	SysTick->CTRL;
-	core_ctx_switch();
+	core_ctx_slice((OS_FREQUENCY)/(OS_ROBIN));
 }
 
 /******************************************************************************
@@ -91,6 +91,16 @@ extern "C" {
 #error  osconfig.h: Incorrect OS_ROBIN value!
 #endif
 
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_TICKLESS
+#define OS_TICKLESS           0 /* system timer interrupts are not suppressed in idle task */
+#endif
+
+#if     OS_TICKLESS && HW_TIMER_SIZE
+#error  osconfig.h: OS_TICKLESS is only available in non-tick-less mode!
+#endif
+
 /* -------------------------------------------------------------------------- */
 // return current system time
 
@@ -159,6 +169,29 @@ void port_tmr_start( uint32_t timeout )
 #endif
 }
 
+/* -------------------------------------------------------------------------- */
+// stop system timer interrupts in non-tick-less mode
+
+__STATIC_INLINE
+void port_tck_suspend( void )
+{
+#if HW_TIMER_SIZE == 0
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+// restart system timer interrupts in non-tick-less mode
+
+__STATIC_INLINE
+void port_tck_resume( void )
+{
+#if HW_TIMER_SIZE == 0
+	SysTick->VAL   = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+
 /* -------------------------------------------------------------------------- */
 // force timer interrupt
 
@@ -45,9 +45,17 @@
 // system mode, round-robin frequency in Hz
 // OS_ROBIN == 0 => os works in cooperative mode
 // OS_ROBIN >  0 => os works in preemptive mode, OS_ROBIN indicates round-robin frequency
+//                   (default time slice of a task: OS_FREQUENCY/OS_ROBIN ticks, may be changed per task with tsk_setSlice)
 // default value: 0
 #define OS_ROBIN           1000
 
+// ----------------------------
+// suppression of system timer interrupts in idle task (non-tick-less mode only, OS_FREQUENCY <= 1000)
+// OS_TICKLESS == 0 => system timer generates interrupts with frequency OS_FREQUENCY all the time
+// OS_TICKLESS == 1 => idle task reprograms system timer to sleep until the nearest timer expiration
+// default value: 0
+#define OS_TICKLESS           0
+
 // ----------------------------
 // critical sections protection level
 // OS_LOCK_LEVEL == 0 or  __CORTEX_M <  3 => entrance to a critical section blocks all interrupts
@@ -60,6 +68,13 @@
 // default value: 0 (the same as priority of idle process)
 #define OS_MAIN_PRIO          0
 
+// ----------------------------
+// number of task priority levels
+// OS_PRIO_LEVELS == 0 => task priorities are unlimited, tasks READY queue is a sorted list
+// OS_PRIO_LEVELS >  0 => task priorities are limited to 0 .. OS_PRIO_LEVELS-1, tasks READY queue is indexed by a priority bitmap
+// default value: 0
+#define OS_PRIO_LEVELS        0
+
 // ----------------------------
 // os heap size in bytes
 // OS_HEAP_SIZE == 0 => functions 'xxx_create' use 'malloc' provided with the compiler libraries
@@ -77,6 +92,36 @@
 // default value: 128
 #define OS_IDLE_STACK       128
 
+// ----------------------------
+// timers queue organization
+// OS_TIMER_WHEEL == 0 => timers queue is a sorted list, insertion time depends on the number of started timers
+// OS_TIMER_WHEEL >  0 => timers queue is a hierarchical timing wheel, OS_TIMER_WHEEL indicates number of wheel levels (32 slots each)
+// default value: 0
+#define OS_TIMER_WHEEL        0
+
+// ----------------------------
+// maximum number of timer expirations handled within one critical section of the timers queue handler
+// OS_TIMER_BATCH == 0 => all expired timers are handled within one critical section
+// OS_TIMER_BATCH >  0 => interrupts are unmasked after every OS_TIMER_BATCH expirations; in tick-less mode the handler is re-pended instead
+// default value: 0
+#define OS_TIMER_BATCH        0
+
+// ----------------------------
+// index scheme of ring buffers (stream buffers, message buffers, mailbox queues, event queues and job queues)
+// OS_RING_POW2 == 0 => all ring buffers wrap their indices at the capacity, power-of-two index paths are not compiled
+// OS_RING_POW2 == 1 => ring buffers with a power-of-two capacity use free-running indices, the scheme is selected at run time
+// OS_RING_POW2 == 2 => all ring buffers must have a power-of-two capacity, wrapping index paths are not compiled
+// default value: 1
+#define OS_RING_POW2          1
+
+// ----------------------------
+// context of timer callback procedures
+// OS_TIMER_TASK == 0 => timer callback procedures are called from the timer interrupt handler
+// OS_TIMER_TASK == 1 => timer callback procedures are called from the timer service task (thread mode),
+//                       OS_TIMER_PRIO (default: the highest priority) and OS_TIMER_STACK (default: OS_STACK_SIZE) indicate priority and stack size of the task
+// default value: 0
+#define OS_TIMER_TASK         0
+
 // ----------------------------
 // bit size of system timer counter
 // available values: 16, 32, 64